@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+
+// Command line values for main and benchmark. Both only accept the whole string, so "12abc" or an empty value is an
+// error instead of being read as whatever prefix parses
+
+// Positive integer
+inline bool ParseCount(const char* text, size_t& out_count)
+{
+	char* end = nullptr;
+	unsigned long long value = std::strtoull(text, &end, 10);
+	if (end == text || *end != '\0' || text[0] == '-' || value == 0)
+	{
+		return false;
+	}
+
+	out_count = static_cast<size_t>(value);
+	return true;
+}
+
+// Positive finite real number
+inline bool ParsePositive(const char* text, double& out_value)
+{
+	char* end = nullptr;
+	double value = std::strtod(text, &end);
+	if (end == text || *end != '\0' || !std::isfinite(value) || !(value > 0.0))
+	{
+		return false;
+	}
+
+	out_value = value;
+	return true;
+}
@@ -0,0 +1,462 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "arguments.h"
+#include "output.h"
+#include "trace.h"
+#include "benchmark/baseline.h"
+#include "benchmark/complexity.h"
+#include "benchmark/registry.h"
+#include "benchmark/statistics.h"
+
+// Heap tracking for the memory side of the complexity report. Every allocation carries a small header with its size
+// so that frees can be accounted for as well
+static constexpr size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+	void* block = std::malloc(size + ALLOCATION_HEADER_SIZE);
+	if (block == nullptr) throw std::bad_alloc();
+
+	*static_cast<size_t*>(block) = size;
+	AllocationTracker::OnAllocate(size);
+	return static_cast<char*>(block) + ALLOCATION_HEADER_SIZE;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (pointer == nullptr) return;
+
+	void* block = static_cast<char*>(pointer) - ALLOCATION_HEADER_SIZE;
+	AllocationTracker::OnFree(*static_cast<size_t*>(block));
+	std::free(block);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* pointer) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, size_t) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { operator delete(pointer); }
+
+// Over-aligned allocations (like AlignedAllocator's) can't use the fixed header, so the block is over-allocated and the
+// header goes right below the aligned pointer: the size, then how far past the start of the block the pointer is
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	size_t align = std::max(static_cast<size_t>(alignment), alignof(size_t));
+	void* block = std::malloc(size + align + 2 * sizeof(size_t));
+	if (block == nullptr) throw std::bad_alloc();
+
+	uintptr_t start = reinterpret_cast<uintptr_t>(block);
+	uintptr_t pointer = (start + 2 * sizeof(size_t) + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+	size_t* header = reinterpret_cast<size_t*>(pointer) - 2;
+	header[0] = size;
+	header[1] = static_cast<size_t>(pointer - start);
+	AllocationTracker::OnAllocate(size);
+	return reinterpret_cast<void*>(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+	if (pointer == nullptr) return;
+
+	size_t* header = static_cast<size_t*>(pointer) - 2;
+	AllocationTracker::OnFree(header[0]);
+	std::free(static_cast<char*>(pointer) - header[1]);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept { operator delete(pointer, alignment); }
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept { operator delete(pointer, alignment); }
+void operator delete[](void* pointer, size_t, std::align_val_t alignment) noexcept { operator delete(pointer, alignment); }
+
+// The report is written through ordered results, numbered in the order they're produced
+static size_t resultSequence = 0;
+
+OutputWriter::ResultStream NextResult()
+{
+	return Result(resultSequence++);
+}
+
+std::string FormatFixed(double value, int decimals)
+{
+	char text[64];
+	std::snprintf(text, sizeof(text), "%.*f", decimals, value);
+	return text;
+}
+
+struct BenchmarkOptions
+{
+	std::string filter;
+	double secondsPerSolver = 10.0;
+	size_t repeats = 3;
+	double tolerance = 0.25;
+
+	// Suite mode
+	size_t samples = 15;
+	std::string machineID;
+	std::string saveBaselinePath;
+	std::string compareBaselinePath;
+	double significance = 0.05;
+};
+
+// Runs one solver over geometrically growing generated inputs until its size or time budget runs out
+std::vector<ScalingSample> MeasureScaling(const BenchmarkEntry& entry, const BenchmarkOptions& options)
+{
+	std::vector<ScalingSample> samples;
+	double secondsSpent = 0.0;
+
+	for (size_t n = entry.minN; n <= entry.maxN; n *= 2)
+	{
+		std::mt19937 rng(static_cast<uint32_t>(0xC0FFEE ^ n));
+		Challenge::Input input = entry.generate(n, rng);
+
+		ScalingSample sample{ static_cast<double>(n), std::numeric_limits<double>::max(), 0.0 };
+		for (size_t r = 0; r < options.repeats; r++)
+		{
+			// The solvers take their input by value, so the copy is made up front to keep it out of the measurement
+			Challenge::Input inputCopy = input;
+			auto challenge = entry.create();
+
+			int64_t baselineBytes = AllocationTracker::ResetPeak();
+			auto start = std::chrono::steady_clock::now();
+			challenge->Run(std::move(inputCopy));
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			int64_t peakBytes = AllocationTracker::PeakBytes().load() - baselineBytes;
+
+			// Best-of-N for time, since noise only ever makes a run slower. Memory is deterministic
+			sample.seconds = std::min(sample.seconds, seconds);
+			sample.peakBytes = std::max(sample.peakBytes, static_cast<double>(peakBytes));
+			secondsSpent += seconds;
+
+			if (secondsSpent > options.secondsPerSolver) break;
+		}
+
+		samples.push_back(sample);
+
+		// Doubling again would at least double the time, so stop once that can't fit into the budget anymore
+		if (secondsSpent + sample.seconds * 2.0 * options.repeats > options.secondsPerSolver) break;
+	}
+
+	return samples;
+}
+
+void ReportComplexity(const BenchmarkOptions& options)
+{
+	NextResult() << "Complexity report (time budget " << options.secondsPerSolver << "s per solver, tolerance " << options.tolerance << ")\n";
+
+	for (const auto& entry : GetBenchmarkEntries())
+	{
+		if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) continue;
+
+		std::vector<ScalingSample> samples = MeasureScaling(entry, options);
+		ComplexityFit timeFit = FitComplexity(samples, [](const ScalingSample& s) { return s.seconds; });
+		ComplexityFit memoryFit = FitComplexity(samples, [](const ScalingSample& s) { return s.peakBytes; });
+
+		{
+			auto result = NextResult();
+			result << entry.name << ":\n";
+			for (const auto& sample : samples)
+			{
+				result << "\tn = " << static_cast<uint64_t>(sample.n) << "\t" << FormatFixed(sample.seconds * 1000.0, 3) << " ms\t" << static_cast<int64_t>(sample.peakBytes) << " bytes\n";
+			}
+		}
+
+		// A few hundred bytes of bookkeeping is all noise, so memory is only judged once it actually grows
+		static constexpr double NEGLIGIBLE_MEMORY_BYTES = 64 * 1024;
+		double largestPeak = 0.0;
+		for (const auto& sample : samples) largestPeak = std::max(largestPeak, sample.peakBytes);
+
+		bool timeFlagged = timeFit.valid && timeFit.exponent > entry.timeExponentTarget + options.tolerance;
+		bool memoryFlagged = memoryFit.valid && largestPeak >= NEGLIGIBLE_MEMORY_BYTES && memoryFit.exponent > entry.memoryExponentTarget + options.tolerance;
+
+		auto result = NextResult();
+		if (!timeFit.valid)
+		{
+			result << "\ttime: not enough samples to fit\n";
+		}
+		else
+		{
+			result << "\ttime:   n^" << FormatFixed(timeFit.exponent, 2) << " (closest model " << timeFit.bestModel << ", target n^" << entry.timeExponentTarget << ")" << (timeFlagged ? " [FLAGGED]" : "") << '\n';
+		}
+
+		if (largestPeak < NEGLIGIBLE_MEMORY_BYTES)
+		{
+			result << "\tmemory: negligible (peak " << static_cast<int64_t>(largestPeak) << " bytes)\n";
+		}
+		else if (memoryFit.valid)
+		{
+			result << "\tmemory: n^" << FormatFixed(memoryFit.exponent, 2) << " (closest model " << memoryFit.bestModel << ", target n^" << entry.memoryExponentTarget << ")" << (memoryFlagged ? " [FLAGGED]" : "") << '\n';
+		}
+
+		OutputWriter::Get().Flush();
+	}
+}
+
+// Runs every solver at fixed input scales and collects one sample per run for the whole run ("total") and for every
+// phase span the solver declares
+BaselineSamples RunSuite(const BenchmarkOptions& options)
+{
+	static const size_t SCALE_MULTIPLIERS[] = { 4, 16 };
+
+	BaselineSamples results;
+	TraceRecorder::Get().SetCollectingPhaseTotals(true);
+
+	for (const auto& entry : GetBenchmarkEntries())
+	{
+		if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) continue;
+
+		for (const auto multiplier : SCALE_MULTIPLIERS)
+		{
+			size_t n = std::min(entry.minN * multiplier, entry.maxN);
+			std::mt19937 rng(static_cast<uint32_t>(0xC0FFEE ^ n));
+			Challenge::Input input = entry.generate(n, rng);
+
+			for (size_t s = 0; s < options.samples; s++)
+			{
+				Challenge::Input inputCopy = input;
+				auto challenge = entry.create();
+
+				TraceRecorder::Get().TakePhaseTotals();
+				auto start = std::chrono::steady_clock::now();
+				challenge->Run(std::move(inputCopy));
+				auto end = std::chrono::steady_clock::now();
+
+				results[{ options.machineID, entry.name, "total", n }].push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+				for (const auto& phase : TraceRecorder::Get().TakePhaseTotals())
+				{
+					results[{ options.machineID, entry.name, phase.first, n }].push_back(static_cast<double>(phase.second));
+				}
+			}
+		}
+	}
+
+	TraceRecorder::Get().SetCollectingPhaseTotals(false);
+	return results;
+}
+
+void ReportSuite(const BenchmarkOptions& options, const BaselineSamples& results, const BaselineSamples& baseline)
+{
+	bool comparing = !baseline.empty();
+
+	NextResult() << "Benchmark suite on '" << options.machineID << "' (" << options.samples << " samples per row"
+		<< (comparing ? ", compared against baseline" : "") << ")\n";
+
+	for (const auto& iter : results)
+	{
+		const auto& key = iter.first;
+		double currentMedian = Median(iter.second);
+
+		auto result = NextResult();
+		result << std::get<1>(key) << "\t" << std::get<2>(key) << "\tn = " << std::get<3>(key) << "\t" << FormatFixed(currentMedian / 1e6, 3) << " ms";
+
+		auto baselineIter = baseline.find(key);
+		if (!comparing)
+		{
+			result << '\n';
+			continue;
+		}
+		if (baselineIter == baseline.end())
+		{
+			result << "\t(no baseline)\n";
+			continue;
+		}
+
+		double baselineMedian = Median(baselineIter->second);
+		double pValue = MannWhitneyPValue(baselineIter->second, iter.second);
+		ConfidenceInterval interval = BootstrapMedianRatio(baselineIter->second, iter.second);
+		double delta = baselineMedian > 0.0 ? (currentMedian / baselineMedian - 1.0) * 100.0 : 0.0;
+
+		// Only call it a change when both tests agree
+		const char* verdict = "no significant change";
+		if (pValue < options.significance && interval.high < 1.0) verdict = "FASTER";
+		else if (pValue < options.significance && interval.low > 1.0) verdict = "SLOWER";
+
+		result << "\tbaseline " << FormatFixed(baselineMedian / 1e6, 3) << " ms\t" << (delta >= 0.0 ? "+" : "") << FormatFixed(delta, 1) << "%"
+			<< "\tratio CI [" << FormatFixed(interval.low, 3) << ", " << FormatFixed(interval.high, 3) << "]"
+			<< "\tp = " << FormatFixed(pValue, 4) << "\t" << verdict << '\n';
+	}
+}
+
+// Runs every engine and the solver it stands in for on the same generated inputs, and reports any answer that differs.
+// Returns false if one did
+bool VerifyEngines(const BenchmarkOptions& options)
+{
+	static const size_t SCALE_MULTIPLIERS[] = { 1, 4, 16, 64 };
+
+	NextResult() << "Verifying engines against their reference solvers\n";
+
+	bool allMatch = true;
+	for (const auto& entry : GetBenchmarkEntries())
+	{
+		if (entry.reference.empty()) continue;
+		if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) continue;
+
+		const BenchmarkEntry* reference = nullptr;
+		for (const auto& candidate : GetBenchmarkEntries())
+		{
+			if (candidate.name == entry.reference) reference = &candidate;
+		}
+
+		if (reference == nullptr)
+		{
+			NextResult() << entry.name << ":\tunknown reference '" << entry.reference << "'\n";
+			allMatch = false;
+			continue;
+		}
+
+		for (const auto multiplier : SCALE_MULTIPLIERS)
+		{
+			size_t n = std::min(entry.minN * multiplier, entry.maxN);
+			std::mt19937 rng(static_cast<uint32_t>(0xC0FFEE ^ n));
+			Challenge::Input input = entry.generate(n, rng);
+
+			int expected = reference->create()->Run(input);
+			int actual = entry.create()->Run(input);
+
+			auto result = NextResult();
+			result << entry.name << "\tn = " << n << "\t";
+			if (actual == expected)
+			{
+				result << "OK\n";
+			}
+			else
+			{
+				result << "MISMATCH: " << actual << ", " << entry.reference << " gives " << expected << '\n';
+				allMatch = false;
+			}
+		}
+	}
+
+	return allMatch;
+}
+
+static const char* const USAGE =
+	"Usage: benchmark --complexity [--filter <name>] [--seconds <per solver>] [--repeats <count>] [--tolerance <exponent>]\n"
+	"       benchmark --suite [--filter <name>] [--samples <count>] [--machine <id>] [--save-baseline <file>] [--compare <file>] [--alpha <p>]\n"
+	"       benchmark --verify [--filter <name>]\n";
+
+int InvalidValue(const std::string& arg, const char* value)
+{
+	Diag() << "[ERROR] Invalid value '" << value << "' for " << arg << '\n' << USAGE;
+	OutputWriter::Get().Flush();
+	return -1;
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	options.machineID = GetMachineID();
+	bool complexity = false;
+	bool suite = false;
+	bool verify = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--complexity")
+		{
+			complexity = true;
+		}
+		else if (arg == "--suite")
+		{
+			suite = true;
+		}
+		else if (arg == "--verify")
+		{
+			verify = true;
+		}
+		else if (arg == "--samples" && i + 1 < argc)
+		{
+			if (!ParseCount(argv[++i], options.samples)) return InvalidValue(arg, argv[i]);
+			options.samples = std::max<size_t>(options.samples, 2);
+		}
+		else if (arg == "--machine" && i + 1 < argc)
+		{
+			options.machineID = argv[++i];
+		}
+		else if (arg == "--save-baseline" && i + 1 < argc)
+		{
+			options.saveBaselinePath = argv[++i];
+		}
+		else if (arg == "--compare" && i + 1 < argc)
+		{
+			options.compareBaselinePath = argv[++i];
+		}
+		else if (arg == "--alpha" && i + 1 < argc)
+		{
+			if (!ParsePositive(argv[++i], options.significance) || options.significance > 1.0) return InvalidValue(arg, argv[i]);
+		}
+		else if (arg == "--filter" && i + 1 < argc)
+		{
+			options.filter = argv[++i];
+		}
+		else if (arg == "--seconds" && i + 1 < argc)
+		{
+			if (!ParsePositive(argv[++i], options.secondsPerSolver)) return InvalidValue(arg, argv[i]);
+		}
+		else if (arg == "--repeats" && i + 1 < argc)
+		{
+			if (!ParseCount(argv[++i], options.repeats)) return InvalidValue(arg, argv[i]);
+		}
+		else if (arg == "--tolerance" && i + 1 < argc)
+		{
+			if (!ParsePositive(argv[++i], options.tolerance)) return InvalidValue(arg, argv[i]);
+		}
+		else
+		{
+			Diag() << "[ERROR] Unknown argument '" << arg << "'" << '\n';
+			OutputWriter::Get().Flush();
+			return -1;
+		}
+	}
+
+	if (!complexity && !suite && !verify)
+	{
+		Diag() << USAGE;
+		OutputWriter::Get().Flush();
+		return -1;
+	}
+
+	BaselineSamples baseline;
+	if (!options.compareBaselinePath.empty() && !LoadBaseline(options.compareBaselinePath, baseline))
+	{
+		Diag() << "[ERROR] Failed to read baseline file '" << options.compareBaselinePath << "'!" << '\n';
+		OutputWriter::Get().Flush();
+		return -1;
+	}
+
+	// The solvers' own diagnostics would dominate the measurements
+	OutputWriter::Get().SetDiagnosticsEnabled(false);
+
+	int returnCode = 0;
+	if (verify && !VerifyEngines(options))
+	{
+		returnCode = -1;
+	}
+
+	if (complexity)
+	{
+		ReportComplexity(options);
+	}
+
+	if (suite)
+	{
+		BaselineSamples results = RunSuite(options);
+		ReportSuite(options, results, baseline);
+
+		if (!options.saveBaselinePath.empty() && !SaveBaseline(options.saveBaselinePath, results))
+		{
+			NextResult() << "[ERROR] Failed to write baseline file '" << options.saveBaselinePath << "'!\n";
+			returnCode = -1;
+		}
+	}
+
+	OutputWriter::Get().Flush();
+	return returnCode;
+}
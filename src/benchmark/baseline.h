@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+// Benchmark results are stored per (machine, challenge, phase, input scale), so one baseline file can hold results from
+// several machines without them ever being compared against each other
+typedef std::tuple<std::string, std::string, std::string, uint64_t> BaselineKey;
+typedef std::map<BaselineKey, std::vector<double>> BaselineSamples;
+
+static const char* const BASELINE_HEADER = "# AdventOfCode-2023 benchmark baseline v1 (machine, challenge, phase, scale, samples in ns)";
+
+// Identifies the machine the samples were taken on: host name plus hardware thread count
+inline std::string GetMachineID()
+{
+	std::string host;
+
+#if defined(_WIN32)
+	const char* computerName = std::getenv("COMPUTERNAME");
+	if (computerName != nullptr) host = computerName;
+#else
+	char hostName[256] = {};
+	if (gethostname(hostName, sizeof(hostName) - 1) == 0) host = hostName;
+#endif
+
+	if (host.empty()) host = "unknown";
+	return host + "-" + std::to_string(std::thread::hardware_concurrency()) + "t";
+}
+
+// Reads a baseline file into out_samples. Returns false if the file can't be opened
+inline bool LoadBaseline(const std::string& path, BaselineSamples& out_samples)
+{
+	std::ifstream file(path);
+	if (!file.good())
+	{
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line[0] == '#') continue;
+
+		std::istringstream fields(line);
+		std::string machine, challenge, phase, scaleStr, samplesStr;
+		if (!std::getline(fields, machine, '\t') ||
+			!std::getline(fields, challenge, '\t') ||
+			!std::getline(fields, phase, '\t') ||
+			!std::getline(fields, scaleStr, '\t') ||
+			!std::getline(fields, samplesStr))
+		{
+			// Malformed line, skip it rather than failing the whole comparison
+			continue;
+		}
+
+		char* end = nullptr;
+		errno = 0;
+		unsigned long long scale = std::strtoull(scaleStr.c_str(), &end, 10);
+		bool valid = end != scaleStr.c_str() && *end == '\0' && scaleStr[0] != '-' && errno != ERANGE;
+
+		std::vector<double> samples;
+		std::istringstream values(samplesStr);
+		std::string value;
+		while (valid && std::getline(values, value, ','))
+		{
+			if (value.empty()) continue;
+
+			samples.push_back(std::strtod(value.c_str(), &end));
+			valid = end != value.c_str() && *end == '\0' && errno != ERANGE;
+		}
+
+		if (!valid)
+		{
+			// Same for a scale or sample that isn't a number
+			continue;
+		}
+
+		out_samples[{ machine, challenge, phase, static_cast<uint64_t>(scale) }] = samples;
+	}
+
+	return true;
+}
+
+// Merges the given samples into the baseline file, replacing any record with the same key and keeping the others
+inline bool SaveBaseline(const std::string& path, const BaselineSamples& samples)
+{
+	BaselineSamples merged;
+	LoadBaseline(path, merged);
+	for (const auto& iter : samples)
+	{
+		merged[iter.first] = iter.second;
+	}
+
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file.good())
+	{
+		return false;
+	}
+
+	file << BASELINE_HEADER << '\n';
+	for (const auto& iter : merged)
+	{
+		const auto& key = iter.first;
+		file << std::get<0>(key) << '\t' << std::get<1>(key) << '\t' << std::get<2>(key) << '\t' << std::get<3>(key) << '\t';
+		for (size_t i = 0; i < iter.second.size(); i++)
+		{
+			if (i > 0) file << ',';
+			file << static_cast<int64_t>(iter.second[i]);
+		}
+		file << '\n';
+	}
+
+	return file.good();
+}
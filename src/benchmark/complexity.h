@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Live heap usage, fed by the global operator new/delete replacements in benchmark.cpp. Only the benchmark target
+// replaces them, so in the regular runner these counters simply stay at zero
+struct AllocationTracker
+{
+	static std::atomic<int64_t>& CurrentBytes()
+	{
+		static std::atomic<int64_t> bytes = 0;
+		return bytes;
+	}
+
+	static std::atomic<int64_t>& PeakBytes()
+	{
+		static std::atomic<int64_t> bytes = 0;
+		return bytes;
+	}
+
+	static void OnAllocate(size_t size)
+	{
+		int64_t current = CurrentBytes().fetch_add(static_cast<int64_t>(size)) + static_cast<int64_t>(size);
+		int64_t peak = PeakBytes().load();
+		while (current > peak && !PeakBytes().compare_exchange_weak(peak, current))
+		{
+		}
+	}
+
+	static void OnFree(size_t size)
+	{
+		CurrentBytes().fetch_sub(static_cast<int64_t>(size));
+	}
+
+	// Starts a new measurement window, returning the live bytes it starts from
+	static int64_t ResetPeak()
+	{
+		int64_t current = CurrentBytes().load();
+		PeakBytes().store(current);
+		return current;
+	}
+};
+
+// One measurement of a solver at input size n
+struct ScalingSample
+{
+	double n;
+	double seconds;
+	double peakBytes;
+};
+
+// Growth models the measurements are compared against
+struct ComplexityModel
+{
+	const char* name;
+	double (*f)(double n);
+};
+
+static const ComplexityModel COMPLEXITY_MODELS[] =
+{
+	{ "n",         [](double n) { return n; } },
+	{ "n log n",   [](double n) { return n * std::log2(n); } },
+	{ "n^2",       [](double n) { return n * n; } },
+	{ "n^2 log n", [](double n) { return n * n * std::log2(n); } },
+	{ "n^3",       [](double n) { return n * n * n; } },
+};
+
+struct ComplexityFit
+{
+	// Exponent k of the least-squares power law y = c * n^k, fitted in log-log space
+	double exponent = 0.0;
+
+	// The model from COMPLEXITY_MODELS that best explains the samples, and its RMS error in log space
+	std::string bestModel;
+	double bestModelError = 0.0;
+
+	bool valid = false;
+};
+
+// Fits y(n) against the power law and every model. Samples with a non-positive y (e.g. no allocations) are skipped
+template<typename GetY>
+ComplexityFit FitComplexity(const std::vector<ScalingSample>& samples, GetY getY)
+{
+	ComplexityFit fit;
+
+	std::vector<std::pair<double, double>> points;
+	for (const auto& sample : samples)
+	{
+		double y = getY(sample);
+		if (y > 0.0 && sample.n > 1.0)
+		{
+			points.push_back({ sample.n, y });
+		}
+	}
+
+	if (points.size() < 3)
+	{
+		return fit;
+	}
+
+	// Power law: log y = log c + k * log n
+	double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+	for (const auto& point : points)
+	{
+		double x = std::log(point.first);
+		double y = std::log(point.second);
+		sumX += x;
+		sumY += y;
+		sumXX += x * x;
+		sumXY += x * y;
+	}
+
+	double count = static_cast<double>(points.size());
+	double denominator = count * sumXX - sumX * sumX;
+	if (denominator == 0.0)
+	{
+		return fit;
+	}
+	fit.exponent = (count * sumXY - sumX * sumY) / denominator;
+
+	// Models: y = c * f(n). The best c in log space is the mean of log(y / f(n)), and the error is what's left over
+	fit.bestModelError = std::numeric_limits<double>::max();
+	for (const auto& model : COMPLEXITY_MODELS)
+	{
+		double logC = 0.0;
+		for (const auto& point : points)
+		{
+			logC += std::log(point.second / model.f(point.first));
+		}
+		logC /= count;
+
+		double error = 0.0;
+		for (const auto& point : points)
+		{
+			double residual = std::log(point.second / model.f(point.first)) - logC;
+			error += residual * residual;
+		}
+		error = std::sqrt(error / count);
+
+		if (error < fit.bestModelError)
+		{
+			fit.bestModelError = error;
+			fit.bestModel = model.name;
+		}
+	}
+
+	fit.valid = true;
+	return fit;
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../challenge.h"
+
+// Synthetic puzzle inputs for the benchmark target. Every generator takes a size n (which is what the complexity fit
+// is done against) and an RNG, and produces an input in the same format as the real puzzle input. The meaning of n
+// is documented per generator
+
+static const char* const NUMBER_WORDS[] = { "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+
+// n = number of calibration lines. Each line mixes letters, digits and (when withWords is set) spelled-out digits
+inline Challenge::Input GenerateDay1Input(size_t n, std::mt19937& rng, bool withWords)
+{
+	std::uniform_int_distribution<int> letter('a', 'z');
+	std::uniform_int_distribution<int> digit(1, 9);
+	std::uniform_int_distribution<int> piece(0, 9);
+	std::uniform_int_distribution<int> pieces(3, 12);
+
+	Challenge::Input input;
+	input.reserve(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		std::string line;
+		int pieceCount = pieces(rng);
+		for (int j = 0; j < pieceCount; j++)
+		{
+			int kind = piece(rng);
+			if (kind < 2)
+			{
+				line += static_cast<char>('0' + digit(rng));
+			}
+			else if (kind < 4 && withWords)
+			{
+				line += NUMBER_WORDS[digit(rng) - 1];
+			}
+			else
+			{
+				line += static_cast<char>(letter(rng));
+			}
+		}
+
+		// Every line needs at least one digit to have a calibration value
+		line += static_cast<char>('0' + digit(rng));
+		input.push_back(line);
+	}
+
+	return input;
+}
+
+// n = number of games, each with 1-6 draws of 1 to maxCubes cubes per color
+inline Challenge::Input GenerateDay2Input(size_t n, std::mt19937& rng, int maxCubes)
+{
+	static const char* const COLORS[] = { "red", "green", "blue" };
+	std::uniform_int_distribution<int> draws(1, 6);
+	std::uniform_int_distribution<int> colorCount(1, 3);
+	std::uniform_int_distribution<int> cubes(1, std::max(maxCubes, 1));
+
+	Challenge::Input input;
+	input.reserve(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		std::string line = "Game " + std::to_string(i + 1) + ":";
+		int drawCount = draws(rng);
+		for (int d = 0; d < drawCount; d++)
+		{
+			int colors = colorCount(rng);
+			int firstColor = colorCount(rng) - 1;
+			for (int c = 0; c < colors; c++)
+			{
+				line += " " + std::to_string(cubes(rng)) + " " + COLORS[(firstColor + c) % 3];
+				if (c + 1 < colors) line += ",";
+			}
+			if (d + 1 < drawCount) line += ";";
+		}
+		input.push_back(line);
+	}
+
+	return input;
+}
+
+// n = number of cells. The schematic is a square grid of ~sqrt(n) x sqrt(n) cells holding numbers and symbols
+inline Challenge::Input GenerateDay3Input(size_t n, std::mt19937& rng)
+{
+	static const char SYMBOLS[] = { '*', '#', '+', '$', '/', '=', '%', '@', '&', '-' };
+	size_t side = std::max<size_t>(static_cast<size_t>(std::sqrt(static_cast<double>(n))), 4);
+	std::uniform_int_distribution<int> roll(0, 99);
+	std::uniform_int_distribution<int> digit(0, 9);
+	std::uniform_int_distribution<int> symbol(0, sizeof(SYMBOLS) - 1);
+
+	Challenge::Input input(side, std::string(side, '.'));
+	for (size_t y = 0; y < side; y++)
+	{
+		for (size_t x = 0; x < side; x++)
+		{
+			int r = roll(rng);
+			if (r < 8 && x + 3 < side)
+			{
+				// 1-3 digit number, followed by at least one '.'
+				int length = 1 + (r % 3);
+				for (int i = 0; i < length; i++)
+				{
+					input[y][x + i] = static_cast<char>('1' + digit(rng) % 9);
+				}
+				x += length;
+			}
+			else if (r < 12)
+			{
+				// Any row, edges included: the Day3 solvers treat everything past the grid as '.'
+				input[y][x] = SYMBOLS[symbol(rng)];
+			}
+		}
+	}
+
+	return input;
+}
+
+// n = number of scratchcards, each with 10 winning numbers and 25 numbers you have. Every card gets a uniformly random
+// number of matches in [0, maxMatches], which keeps the number of card copies in part 2 under control
+inline Challenge::Input GenerateDay4Input(size_t n, std::mt19937& rng, int maxMatches)
+{
+	std::vector<int> pool(99);
+	for (int i = 0; i < 99; i++) pool[i] = i + 1;
+
+	std::uniform_int_distribution<int> matchCount(0, std::min(maxMatches, 10));
+	auto formatNumber = [](int number) { return number < 10 ? " " + std::to_string(number) : std::to_string(number); };
+
+	Challenge::Input input;
+	input.reserve(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		std::string line = "Card " + std::to_string(i + 1) + ":";
+
+		// The first 10 numbers of the pool are the winning ones, the numbers you have are taken from the front for the
+		// matches and from past the winning numbers for the rest
+		std::shuffle(pool.begin(), pool.end(), rng);
+		// Like the real puzzle, cards never hand out copies past the end of the table
+		int matches = std::min<int>(matchCount(rng), static_cast<int>(n - 1 - i));
+
+		std::vector<int> personal(pool.begin(), pool.begin() + matches);
+		personal.insert(personal.end(), pool.begin() + 10, pool.begin() + 10 + (25 - matches));
+		std::shuffle(personal.begin(), personal.end(), rng);
+
+		for (int j = 0; j < 10; j++) line += " " + formatNumber(pool[j]);
+		line += " |";
+		for (const auto number : personal) line += " " + formatNumber(number);
+
+		input.push_back(line);
+	}
+
+	return input;
+}
+
+// n = race time of the single (kerned) race
+inline Challenge::Input GenerateDay6Input(size_t n, std::mt19937& /*rng*/)
+{
+	uint64_t record = (static_cast<uint64_t>(n) * n) / 5;
+	return { "Time: " + std::to_string(n), "Distance: " + std::to_string(record) };
+}
+
+// n = number of distinct hands
+inline Challenge::Input GenerateDay7Input(size_t n, std::mt19937& rng)
+{
+	static const char CARDS[] = { '2', '3', '4', '5', '6', '7', '8', '9', 'T', 'J', 'Q', 'K', 'A' };
+	std::uniform_int_distribution<int> card(0, sizeof(CARDS) - 1);
+	std::uniform_int_distribution<int> bid(1, 1000);
+
+	// The solvers key hands in a map, so duplicates would silently shrink the input
+	std::vector<std::string> hands;
+	std::vector<bool> used(13 * 13 * 13 * 13 * 13, false);
+	while (hands.size() < n && hands.size() < used.size())
+	{
+		std::string hand(5, ' ');
+		size_t key = 0;
+		for (auto& c : hand)
+		{
+			int index = card(rng);
+			c = CARDS[index];
+			key = key * 13 + index;
+		}
+		if (used[key]) continue;
+		used[key] = true;
+		hands.push_back(hand);
+	}
+
+	Challenge::Input input;
+	input.reserve(hands.size());
+	for (const auto& hand : hands)
+	{
+		input.push_back(hand + " " + std::to_string(bid(rng)));
+	}
+
+	return input;
+}
+
+// n = number of nodes, split over 4 ghosts. Each ghost walks its own chain from a "..A" node to a "..Z" node, and
+// both exits of every node lead to the next one, so the step count only depends on the chain length
+inline Challenge::Input GenerateDay8Input(size_t n, std::mt19937& rng)
+{
+	static constexpr size_t GHOSTS = 4;
+	std::uniform_int_distribution<int> direction(0, 1);
+
+	// Middle nodes can't end in 'A' or 'Z', which leaves 26 * 26 * 24 names
+	auto nodeName = [](size_t index, char last)
+	{
+		std::string name(3, ' ');
+		name[0] = static_cast<char>('A' + (index / 26) % 26);
+		name[1] = static_cast<char>('A' + index % 26);
+		name[2] = last != 0 ? last : static_cast<char>('B' + (index / 676) % 24);
+		return name;
+	};
+
+	std::string steps;
+	for (int i = 0; i < 271; i++) steps += direction(rng) ? 'L' : 'R';
+
+	Challenge::Input input = { steps, "" };
+
+	size_t chainLength = std::max<size_t>(n / GHOSTS, 3);
+	size_t middleIndex = 0;
+	for (size_t ghost = 0; ghost < GHOSTS; ghost++)
+	{
+		// Chain layout: start, middle nodes..., end. The end node loops back to the first middle node
+		std::vector<std::string> chain;
+		chain.push_back(nodeName(ghost, 'A'));
+		for (size_t i = 0; i + 2 < chainLength + ghost; i++)
+		{
+			chain.push_back(nodeName(middleIndex++, 0));
+		}
+		chain.push_back(nodeName(ghost, 'Z'));
+
+		for (size_t i = 0; i < chain.size(); i++)
+		{
+			const std::string& next = (i + 1 < chain.size()) ? chain[i + 1] : chain[1];
+			input.push_back(chain[i] + " = (" + next + ", " + next + ")");
+		}
+	}
+
+	return input;
+}
+
+// n = number of histories, each with 21 values generated from a polynomial of degree <= 5
+inline Challenge::Input GenerateDay9Input(size_t n, std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> degree(1, 5);
+	std::uniform_int_distribution<int> coefficient(-3, 3);
+
+	Challenge::Input input;
+	input.reserve(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		int coefficients[6] = {};
+		int d = degree(rng);
+		for (int j = 0; j <= d; j++) coefficients[j] = coefficient(rng);
+
+		std::string line;
+		for (int x = 0; x < 21; x++)
+		{
+			int64_t value = 0;
+			for (int j = d; j >= 0; j--) value = value * x + coefficients[j];
+			if (x > 0) line += " ";
+			line += std::to_string(value);
+		}
+		input.push_back(line);
+	}
+
+	return input;
+}
+
+// n = loop length. The maze is a single rectangular loop with 'S' in its top-left corner, n / 2 cells wide and 4 rows
+// high, so the grid the solver has to read grows like n as well
+inline Challenge::Input GenerateDay10Input(size_t n, std::mt19937& /*rng*/)
+{
+	static constexpr size_t HEIGHT = 4;
+	size_t width = std::max<size_t>(n / 2, 4) - 1;
+
+	Challenge::Input input;
+	input.reserve(HEIGHT);
+	input.push_back("S" + std::string(width - 2, '-') + "7");
+	for (size_t y = 1; y + 1 < HEIGHT; y++)
+	{
+		input.push_back("|" + std::string(width - 2, '.') + "|");
+	}
+	input.push_back("L" + std::string(width - 2, '-') + "J");
+
+	return input;
+}
+
+// n = number of galaxies, scattered over a square image with roughly a quarter of its rows and columns empty
+inline Challenge::Input GenerateDay11Input(size_t n, std::mt19937& rng)
+{
+	size_t side = std::max<size_t>(static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n) * 4.0))), 4);
+	std::uniform_int_distribution<size_t> coordinate(0, side - 1);
+
+	std::vector<bool> emptyLine(side, false);
+	for (size_t i = 0; i < side; i += 4) emptyLine[i] = true;
+
+	Challenge::Input input(side, std::string(side, '.'));
+	size_t placed = 0;
+	while (placed < n)
+	{
+		size_t x = coordinate(rng);
+		size_t y = coordinate(rng);
+		if (emptyLine[x] || emptyLine[y] || input[y][x] == '#') continue;
+
+		input[y][x] = '#';
+		placed++;
+	}
+
+	return input;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../challenge.h"
+#include "../day1/day1.h"
+#include "../day2/day2.h"
+#include "../day3/day3.h"
+#include "../day4/day4.h"
+#include "../day6/day6.h"
+#include "../day7/day7.h"
+#include "../day8/day8.h"
+#include "../day9/day9.h"
+#include "../day10/day10.h"
+#include "../day11/day11.h"
+#include "generators.h"
+#include "variants.h"
+
+// Everything the benchmark target knows how to run. The exponent targets are what each solver *should* scale like
+// for its definition of n, and are what the complexity report flags against
+struct BenchmarkEntry
+{
+	std::string name;
+	std::function<std::unique_ptr<Challenge>()> create;
+	std::function<Challenge::Input(size_t n, std::mt19937& rng)> generate;
+
+	// Sizes run from minN, doubling every step, until maxN or the time budget is reached
+	size_t minN;
+	size_t maxN;
+
+	double timeExponentTarget;
+	double memoryExponentTarget;
+
+	// For the engines in variants.h: the entry whose answers this one has to match under --verify
+	std::string reference = std::string();
+};
+
+template<typename T>
+std::function<std::unique_ptr<Challenge>()> MakeFactory()
+{
+	return []() { return std::make_unique<T>(); };
+}
+
+inline const std::vector<BenchmarkEntry>& GetBenchmarkEntries()
+{
+	static const std::vector<BenchmarkEntry> entries =
+	{
+		{ "Day1_1", MakeFactory<Day1_1>(), [](size_t n, std::mt19937& rng) { return GenerateDay1Input(n, rng, false); }, 1024, 1u << 22, 1.0, 1.0 },
+		{ "Day1_2", MakeFactory<Day1_2>(), [](size_t n, std::mt19937& rng) { return GenerateDay1Input(n, rng, true); }, 1024, 1u << 22, 1.0, 1.0 },
+		{ "Day1_1_parallel", MakeFactory<Day1ParallelChallenge<1>>(), [](size_t n, std::mt19937& rng) { return GenerateDay1Input(n, rng, false); }, 1024, 1u << 22, 1.0, 1.0, "Day1_1" },
+		{ "Day1_2_parallel", MakeFactory<Day1ParallelChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay1Input(n, rng, true); }, 1024, 1u << 22, 1.0, 1.0, "Day1_2" },
+		{ "Day1_2_mapped", MakeFactory<Day1MappedChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay1Input(n, rng, true); }, 1024, 1u << 22, 1.0, 1.0, "Day1_2" },
+		{ "Day1_1_incremental", MakeFactory<Day1IncrementalChallenge<1>>(), [](size_t n, std::mt19937& rng) { return GenerateDay1Input(n, rng, false); }, 1024, 1u << 22, 1.0, 1.0, "Day1_1" },
+		{ "Day1_2_incremental", MakeFactory<Day1IncrementalChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay1Input(n, rng, true); }, 1024, 1u << 22, 1.0, 1.0, "Day1_2" },
+		{ "Day2_1", MakeFactory<Day2_1>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 20); }, 1024, 1u << 20, 1.0, 1.0 },
+		{ "Day2_2", MakeFactory<Day2_2>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 20); }, 1024, 1u << 20, 1.0, 1.0 },
+		{ "Day2_1_index", MakeFactory<Day2IndexChallenge>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 20); }, 1024, 1u << 20, 1.0, 1.0, "Day2_1" },
+		{ "Day2_1_parallel", MakeFactory<Day2ParallelChallenge<1>>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 20); }, 1024, 1u << 20, 1.0, 1.0, "Day2_1" },
+		{ "Day2_2_parallel", MakeFactory<Day2ParallelChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 20); }, 1024, 1u << 20, 1.0, 1.0, "Day2_2" },
+		{ "Day2_1_colors", MakeFactory<Day2ColorMatrixChallenge<1>>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 20); }, 1024, 1u << 20, 1.0, 1.0, "Day2_1" },
+		{ "Day2_2_colors", MakeFactory<Day2ColorMatrixChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 20); }, 1024, 1u << 20, 1.0, 1.0, "Day2_2" },
+		{ "Day2_2_colors_wide", MakeFactory<Day2ColorMatrixChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 1 << 20); }, 1024, 1u << 20, 1.0, 1.0, "Day2_2" },
+		{ "Day2_queries_wide", MakeFactory<Day2QueriesChallenge<false>>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 1 << 20); }, 1024, 1u << 20, 1.0, 1.0 },
+		{ "Day2_queries_wide_index", MakeFactory<Day2QueriesChallenge<true>>(), [](size_t n, std::mt19937& rng) { return GenerateDay2Input(n, rng, 1 << 20); }, 1024, 1u << 20, 1.0, 1.0, "Day2_queries_wide" },
+		{ "Day3_1", MakeFactory<Day3_1>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0 },
+		{ "Day3_2", MakeFactory<Day3_2>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0 },
+		{ "Day3_1_parallel", MakeFactory<Day3ParallelChallenge<1>>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0, "Day3_1" },
+		{ "Day3_2_parallel", MakeFactory<Day3ParallelChallenge<2>>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0, "Day3_2" },
+		{ "Day3_1_incremental", MakeFactory<Day3IncrementalChallenge<1>>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0, "Day3_1" },
+		{ "Day3_2_incremental", MakeFactory<Day3IncrementalChallenge<2>>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0, "Day3_2" },
+		{ "Day3_1_sparse", MakeFactory<Day3SparseChallenge<1>>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0, "Day3_1" },
+		{ "Day3_2_sparse", MakeFactory<Day3SparseChallenge<2>>(), GenerateDay3Input, 1024, 1u << 22, 1.0, 1.0, "Day3_2" },
+		{ "Day4_1", MakeFactory<Day4_1>(), [](size_t n, std::mt19937& rng) { return GenerateDay4Input(n, rng, 10); }, 256, 1u << 20, 1.0, 1.0 },
+		{ "Day4_2", MakeFactory<Day4_2>(), [](size_t n, std::mt19937& rng) { return GenerateDay4Input(n, rng, 2); }, 256, 1u << 20, 1.0, 1.0 },
+		{ "Day4_1_parallel", MakeFactory<Day4ParallelChallenge<1>>(), [](size_t n, std::mt19937& rng) { return GenerateDay4Input(n, rng, 10); }, 256, 1u << 20, 1.0, 1.0, "Day4_1" },
+		{ "Day4_2_parallel", MakeFactory<Day4ParallelChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay4Input(n, rng, 2); }, 256, 1u << 20, 1.0, 1.0, "Day4_2" },
+		{ "Day4_1_stream", MakeFactory<Day4StreamChallenge<1>>(), [](size_t n, std::mt19937& rng) { return GenerateDay4Input(n, rng, 10); }, 256, 1u << 20, 1.0, 1.0, "Day4_1" },
+		{ "Day4_2_stream", MakeFactory<Day4StreamChallenge<2>>(), [](size_t n, std::mt19937& rng) { return GenerateDay4Input(n, rng, 2); }, 256, 1u << 20, 1.0, 1.0, "Day4_2" },
+		{ "Day6_2", MakeFactory<Day6_2>(), GenerateDay6Input, 1u << 16, 1u << 30, 1.0, 0.0 },
+		{ "Day7_1", MakeFactory<Day7_1>(), GenerateDay7Input, 256, 1u << 18, 1.1, 1.0 },
+		{ "Day7_2", MakeFactory<Day7_2>(), GenerateDay7Input, 256, 1u << 18, 1.1, 1.0 },
+		{ "Day8_2", MakeFactory<Day8_2>(), GenerateDay8Input, 64, 8192, 1.0, 1.0 },
+		{ "Day9_1", MakeFactory<Day9_1>(), GenerateDay9Input, 256, 1u << 20, 1.0, 1.0 },
+		{ "Day10_1", MakeFactory<Day10_1>(), GenerateDay10Input, 64, 1u << 16, 1.0, 1.0 },
+		{ "Day11_1", MakeFactory<Day11_1>(), GenerateDay11Input, 8, 1u << 12, 2.0, 1.0 },
+	};
+
+	return entries;
+}
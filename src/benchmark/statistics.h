@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Small statistics toolkit for comparing two sets of timing samples without assuming they're normally distributed
+
+inline double Median(std::vector<double> values)
+{
+	if (values.empty()) return 0.0;
+
+	std::sort(values.begin(), values.end());
+	size_t middle = values.size() / 2;
+	if (values.size() % 2 == 0)
+	{
+		return (values[middle - 1] + values[middle]) * 0.5;
+	}
+	return values[middle];
+}
+
+// Two-sided Mann-Whitney U test. Returns the p-value for "both sample sets come from the same distribution", using
+// the normal approximation with tie correction (fine from ~8 samples per side, which is what the suite collects)
+inline double MannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b)
+{
+	size_t n1 = a.size();
+	size_t n2 = b.size();
+	if (n1 == 0 || n2 == 0) return 1.0;
+
+	// Rank both sets together, giving tied values their average rank
+	std::vector<std::pair<double, int>> combined;
+	combined.reserve(n1 + n2);
+	for (const auto value : a) combined.push_back({ value, 0 });
+	for (const auto value : b) combined.push_back({ value, 1 });
+	std::sort(combined.begin(), combined.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+	double rankSumA = 0.0;
+	double tieCorrection = 0.0;
+	size_t i = 0;
+	while (i < combined.size())
+	{
+		size_t j = i;
+		while (j < combined.size() && combined[j].first == combined[i].first) j++;
+
+		double averageRank = (static_cast<double>(i + 1) + static_cast<double>(j)) * 0.5;
+		for (size_t k = i; k < j; k++)
+		{
+			if (combined[k].second == 0) rankSumA += averageRank;
+		}
+
+		double tied = static_cast<double>(j - i);
+		tieCorrection += tied * tied * tied - tied;
+		i = j;
+	}
+
+	double N = static_cast<double>(n1 + n2);
+	double u = rankSumA - static_cast<double>(n1 * (n1 + 1)) * 0.5;
+	double meanU = static_cast<double>(n1 * n2) * 0.5;
+	double varianceU = static_cast<double>(n1 * n2) / 12.0 * ((N + 1.0) - tieCorrection / (N * (N - 1.0)));
+	if (varianceU <= 0.0) return 1.0;
+
+	// Continuity correction towards the mean
+	double z = (std::abs(u - meanU) - 0.5) / std::sqrt(varianceU);
+	z = std::max(z, 0.0);
+	return std::erfc(z / std::sqrt(2.0));
+}
+
+struct ConfidenceInterval
+{
+	double low;
+	double high;
+};
+
+// Percentile bootstrap of median(current) / median(baseline). An interval entirely below 1 is a measured speedup,
+// entirely above 1 a measured regression
+inline ConfidenceInterval BootstrapMedianRatio(const std::vector<double>& baseline, const std::vector<double>& current, double confidence = 0.95, int resamples = 2000)
+{
+	if (baseline.empty() || current.empty()) return { 1.0, 1.0 };
+
+	// Fixed seed, so that running the comparison twice on the same data gives the same answer
+	std::mt19937 rng(12345);
+	std::uniform_int_distribution<size_t> pickBaseline(0, baseline.size() - 1);
+	std::uniform_int_distribution<size_t> pickCurrent(0, current.size() - 1);
+
+	std::vector<double> ratios;
+	ratios.reserve(resamples);
+
+	std::vector<double> baselineResample(baseline.size());
+	std::vector<double> currentResample(current.size());
+	for (int r = 0; r < resamples; r++)
+	{
+		for (auto& value : baselineResample) value = baseline[pickBaseline(rng)];
+		for (auto& value : currentResample) value = current[pickCurrent(rng)];
+
+		double baselineMedian = Median(baselineResample);
+		if (baselineMedian <= 0.0) continue;
+		ratios.push_back(Median(currentResample) / baselineMedian);
+	}
+
+	if (ratios.empty()) return { 1.0, 1.0 };
+
+	std::sort(ratios.begin(), ratios.end());
+	double tail = (1.0 - confidence) * 0.5;
+	size_t lowIndex = static_cast<size_t>(tail * (ratios.size() - 1));
+	size_t highIndex = static_cast<size_t>((1.0 - tail) * (ratios.size() - 1));
+	return { ratios[lowIndex], ratios[highIndex] };
+}
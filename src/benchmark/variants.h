@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../challenge.h"
+#include "../thread_pool.h"
+#include "../day1/day1_engine.h"
+#include "../day1/day1_incremental.h"
+#include "../day2/color_matrix.h"
+#include "../day2/cube_limit_index.h"
+#include "../day2/day2_engine.h"
+#include "../day3/day3_engine.h"
+#include "../day3/incremental_schematic.h"
+#include "../day3/sparse_schematic.h"
+#include "../day4/day4_engine.h"
+#include "../day4/scratchcard_stream.h"
+
+// Challenge wrappers around the engines that answer the same questions as a sequential solver in a different way
+// (in parallel, from a file, incrementally...). They're registered next to the solver they replace, so the benchmark
+// measures them on the same inputs and --verify checks that they give the same answers. Part selects which of the two
+// sums an engine computes is returned.
+//
+// The dayN.h solver headers have no include guard, so this relies on registry.h including them first (for things like
+// DRAW_LIMITS)
+
+inline std::string JoinLines(const Challenge::Input& input)
+{
+	std::string document;
+	for (const auto& line : input)
+	{
+		document += line;
+		document += '\n';
+	}
+	return document;
+}
+
+// Writes contents to a file in the temporary directory and returns its path, or an empty string if it can't be written
+inline std::string WriteTemporaryFile(const std::string& name, const std::string& contents)
+{
+	std::error_code error;
+	std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+	if (error)
+	{
+		return std::string();
+	}
+
+	std::string path = (directory / name).string();
+	std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+	return file.good() ? path : std::string();
+}
+
+// Block size for the engines that split their input into blocks: always a few of them, so that block edges are
+// exercised whatever the input size
+static constexpr size_t VARIANT_BLOCK_COUNT = 16;
+
+inline size_t GetVariantBlockSize(size_t lineCount)
+{
+	return std::max<size_t>(lineCount / VARIANT_BLOCK_COUNT, 1);
+}
+
+template<int Part>
+int SelectPart(uint64_t part1, uint64_t part2)
+{
+	return static_cast<int>(Part == 1 ? part1 : part2);
+}
+
+// Day1Engine::SumParallel over the whole document in memory
+template<int Part>
+struct Day1ParallelChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		Day1Sums sums = Day1Engine::SumParallel(JoinLines(input), ThreadPool::Get());
+		return SelectPart<Part>(sums.digits, sums.spelled);
+	}
+};
+
+// Day1Engine::SumFile, which reads the document through a MappedFile
+template<int Part>
+struct Day1MappedChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		std::string path = WriteTemporaryFile("aoc_day1_mapped.txt", JoinLines(input));
+
+		Day1Sums sums;
+		bool read = !path.empty() && Day1Engine::SumFile(path, ThreadPool::Get(), sums);
+		if (!path.empty()) std::remove(path.c_str());
+
+		return read ? SelectPart<Part>(sums.digits, sums.spelled) : -1;
+	}
+};
+
+// Day1IncrementalAggregator following a log that the document is appended to in APPEND_COUNT pieces, cut anywhere
+// (mostly in the middle of a line), with an update after every piece
+template<int Part>
+struct Day1IncrementalChallenge : public Challenge
+{
+	static constexpr size_t APPEND_COUNT = 8;
+
+	int Run(Input input)
+	{
+		std::string document = JoinLines(input);
+		std::string logPath = WriteTemporaryFile("aoc_day1_incremental.log", std::string());
+		if (logPath.empty())
+		{
+			return -1;
+		}
+
+		std::string statePath = logPath + ".state";
+		std::remove(statePath.c_str());
+
+		int answer = -1;
+		{
+			Day1IncrementalAggregator aggregator(logPath, statePath);
+			size_t written = 0;
+			bool read = true;
+			for (size_t piece = 1; piece <= APPEND_COUNT && read; piece++)
+			{
+				size_t end = document.size() * piece / APPEND_COUNT;
+				{
+					std::ofstream log(logPath, std::ios::out | std::ios::binary | std::ios::app);
+					log.write(document.data() + written, static_cast<std::streamsize>(end - written));
+				}
+				written = end;
+				read = aggregator.Update() >= 0;
+			}
+
+			if (read)
+			{
+				answer = SelectPart<Part>(aggregator.GetSums().digits, aggregator.GetSums().spelled);
+			}
+		}
+
+		std::remove(logPath.c_str());
+		std::remove(statePath.c_str());
+		return answer;
+	}
+};
+
+// CubeLimitIndex asked the Day2_1 question. With the usual few distinct counts per color that's the prefix sum grid
+struct Day2IndexChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		GameMaximaStore store;
+		store.Reserve(input.size());
+		for (const auto& line : input)
+		{
+			store.AddRecord(line);
+		}
+
+		CubeLimitIndex index(store);
+		return static_cast<int>(index.SumPossibleIDs(DRAW_LIMITS));
+	}
+};
+
+// Many limit questions against the same games: QUERY_STEPS^3 limits spread over the range of the counts, answers added
+// up. UseIndex picks between a CubeLimitIndex batch and one GameMaximaStore scan per question. With wide counts the
+// index is the k-d tree, which the Day2_1 limits can't check since hardly any game passes them
+template<bool UseIndex>
+struct Day2QueriesChallenge : public Challenge
+{
+	static constexpr uint32_t QUERY_STEPS = 4;
+
+	int Run(Input input)
+	{
+		GameMaximaStore store;
+		store.Reserve(input.size());
+		for (const auto& line : input)
+		{
+			store.AddRecord(line);
+		}
+
+		uint32_t highest = 0;
+		for (size_t game = 0; game < store.GetGameCount(); game++)
+		{
+			CubeCounts maxima = store.GetMaxima(game);
+			highest = std::max({ highest, maxima.red, maxima.green, maxima.blue });
+		}
+
+		std::vector<CubeCounts> queries;
+		for (uint32_t r = 1; r <= QUERY_STEPS; r++)
+		{
+			for (uint32_t g = 1; g <= QUERY_STEPS; g++)
+			{
+				for (uint32_t b = 1; b <= QUERY_STEPS; b++)
+				{
+					queries.push_back({ highest / QUERY_STEPS * r, highest / QUERY_STEPS * g, highest / QUERY_STEPS * b });
+				}
+			}
+		}
+
+		uint64_t sum = 0;
+		if (UseIndex)
+		{
+			CubeLimitIndex index(store);
+			for (const auto& answer : index.SumPossibleIDs(queries, ThreadPool::Get()))
+			{
+				sum += answer;
+			}
+		}
+		else
+		{
+			for (const auto& query : queries)
+			{
+				sum += store.SumPossibleIDs(query);
+			}
+		}
+
+		return static_cast<int>(sum);
+	}
+};
+
+// GameColorMatrix, with the colors interned from the records at runtime instead of being fixed to red, green and blue
+template<int Part>
+struct Day2ColorMatrixChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		GameColorMatrix matrix;
+		for (const auto& line : input)
+		{
+			matrix.AddRecord(line);
+		}
+
+		if (Part == 2)
+		{
+			return static_cast<int>(matrix.SumPowers());
+		}
+
+		std::vector<uint32_t> limits = matrix.GetSchema().MakeLimits({ { "red", DRAW_LIMITS.red }, { "green", DRAW_LIMITS.green }, { "blue", DRAW_LIMITS.blue } });
+		return static_cast<int>(matrix.SumPossibleIDs(limits));
+	}
+};
+
+// Day2Engine, with the per-block stores and reductions on the pool
+template<int Part>
+struct Day2ParallelChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		Day2Sums sums = Day2Engine::Evaluate(input, DRAW_LIMITS, ThreadPool::Get(), GetVariantBlockSize(input.size()));
+		return SelectPart<Part>(sums.possibleIDs, sums.powers);
+	}
+};
+
+// Day3Engine, the schematic cut into bands with halo rows
+template<int Part>
+struct Day3ParallelChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		Day3Sums sums = Day3Engine::Evaluate(input, ThreadPool::Get(), GetVariantBlockSize(input.size()));
+		return SelectPart<Part>(sums.partNumbers, sums.gearRatios);
+	}
+};
+
+// IncrementalSchematic built from a damaged copy of the schematic, where every EDIT_STRIDE-th cell is flipped ('.' to
+// '*', anything else to '.'), then repaired with EDIT_BATCHES batches of edits. The sums it ends up with have to be
+// those of the original schematic
+template<int Part>
+struct Day3IncrementalChallenge : public Challenge
+{
+	static constexpr size_t EDIT_STRIDE = 7;
+	static constexpr size_t EDIT_BATCHES = 4;
+
+	int Run(Input input)
+	{
+		Input damaged = input;
+		std::vector<CellEdit> edits;
+		size_t cell = 0;
+		for (uint32_t y = 0; y < damaged.size(); y++)
+		{
+			for (uint32_t x = 0; x < damaged[y].size(); x++, cell++)
+			{
+				if (cell % EDIT_STRIDE != 0) continue;
+
+				edits.push_back({ x, y, damaged[y][x] });
+				damaged[y][x] = damaged[y][x] == '.' ? '*' : '.';
+			}
+		}
+
+		IncrementalSchematic schematic(damaged);
+		size_t batchSize = std::max<size_t>((edits.size() + EDIT_BATCHES - 1) / EDIT_BATCHES, 1);
+		for (size_t begin = 0; begin < edits.size(); begin += batchSize)
+		{
+			std::vector<CellEdit> batch(edits.begin() + begin, edits.begin() + std::min(edits.size(), begin + batchSize));
+			schematic.ApplyEdits(batch);
+		}
+
+		return SelectPart<Part>(schematic.GetPartNumberSum(), schematic.GetGearRatioSum());
+	}
+};
+
+// SparseSchematic, added row by row and answered from the runs alone
+template<int Part>
+struct Day3SparseChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		SparseSchematic schematic;
+		for (const auto& line : input)
+		{
+			schematic.AddRow(line);
+		}
+
+		return SelectPart<Part>(schematic.SumPartNumbers(), schematic.SumGearRatios());
+	}
+};
+
+// Day4Engine, with both the scoring and the copy counting split into blocks
+template<int Part>
+struct Day4ParallelChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		size_t blockSize = GetVariantBlockSize(input.size());
+		Day4Sums sums;
+		if (!Day4Engine::Evaluate(input, ThreadPool::Get(), sums, blockSize, blockSize))
+		{
+			return -1;
+		}
+
+		return SelectPart<Part>(sums.points, sums.totalCards);
+	}
+};
+
+// ScratchcardStream reading the document as a stream, one card at a time
+template<int Part>
+struct Day4StreamChallenge : public Challenge
+{
+	int Run(Input input)
+	{
+		std::istringstream stream(JoinLines(input));
+		ScratchcardStream cards;
+		if (!cards.ReadStream(stream))
+		{
+			return -1;
+		}
+
+		return SelectPart<Part>(cards.GetTotals().points, cards.GetTotals().totalCards);
+	}
+};
@@ -21,9 +21,9 @@
 // 
 // Consider your entire calibration document.What is the sum of all of the calibration values ?
 
-#include <unordered_map>
-
 #include "../challenge.h"
+#include "digit_scan.h"
+#include "word_matcher.h"
 
 struct Day1_1 : public Challenge
 {
@@ -31,92 +31,29 @@ struct Day1_1 : public Challenge
 	{
 		int sum = 0;
 
-		for (auto line : input)
+		for (const auto& line : input)
 		{
-			int first = -1;
-			int last = -1;
-			for (auto character : line)
-			{
-				if (std::isdigit(character))
-				{
-					// NOTE - Maybe we could do something clever with this function returning 0?
-					int digit = atoi(&character);
-
-					if (first == -1)
-					{
-						first = digit;
-						last = digit;
-					}
-
-					last = digit;
-				}
-			}
-
-			sum += first * 10 + last;
+			// Lines without any digits (like the empty line at the end of the file) don't contribute anything
+			const char* begin = line.data();
+			sum += static_cast<int>(DigitCalibrationValue(begin, begin + line.size()));
 		}
 
 		return sum;
 	}
 };
 
-static const std::unordered_map<std::string, int> STRING_TO_NUMBER =
-{
-	{ "one", 1 },
-	{ "two", 2 },
-	{ "three", 3 },
-	{ "four", 4 },
-	{ "five", 5 },
-	{ "six", 6 },
-	{ "seven", 7 },
-	{ "eight", 8 },
-	{ "nine", 9 },
-};
-
 struct Day1_2 : public Challenge
 {
 	int Run(std::vector<std::string> input)
 	{
 		int sum = 0;
 
-		for (auto line : input)
+		for (const auto& line : input)
 		{
-			int first = -1;
-			int last = -1;
-			for (int i = 0; i < line.size(); i++)
-			{
-				char character = line[i];
-				if (std::isdigit(character))
-				{
-					int digit = atoi(&character);
-
-					if (first == -1)
-					{
-						first = digit;
-					}
-
-					last = digit;
-				}
-				else
-				{
-					for (auto iter : STRING_TO_NUMBER)
-					{
-						int pos = line.find(iter.first, i);
-						if (pos == i && pos != std::string::npos)
-						{
-							if (first == -1)
-							{
-								first = iter.second;
-							}
-
-							last = iter.second;
-							break;
-						}
-					}
-				}
-			}
-			sum += first * 10 + last;
+			const char* begin = line.data();
+			sum += static_cast<int>(EnglishDigitMatcher::CalibrationValue(begin, begin + line.size()));
 		}
 
 		return sum;
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../mapped_file.h"
+#include "../thread_pool.h"
+#include "digit_scan.h"
+#include "word_matcher.h"
+
+struct Day1Sums
+{
+	uint64_t digits = 0;
+	uint64_t spelled = 0;
+};
+
+// Runs the Day 1 kernels straight over a whole calibration document in memory, without splitting it into per-line
+// strings first. Sums are 64-bit, since a document of millions of lines overflows the int that Challenge::Run returns
+class Day1Engine
+{
+public:
+
+	// Small enough that a chunk is still in L2 when the part 2 kernel goes over it after the part 1 kernel
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+
+	// Calls kernel(lineBegin, lineEnd) on every newline-terminated line of the buffer (the last line doesn't need a
+	// terminator) and adds up what it returns
+	template<typename LineKernel>
+	static uint64_t SumLines(const char* data, size_t size, LineKernel kernel)
+	{
+		uint64_t sum = 0;
+
+		const char* current = data;
+		const char* end = data + size;
+		while (current < end)
+		{
+			const char* lineEnd = static_cast<const char*>(memchr(current, '\n', end - current));
+			if (lineEnd == nullptr)
+			{
+				lineEnd = end;
+			}
+
+			sum += kernel(current, lineEnd);
+			current = lineEnd + 1;
+		}
+
+		return sum;
+	}
+
+	// Part 1: first and last digit of every line
+	static uint64_t SumDigitValues(std::string_view document)
+	{
+		return SumLines(document.data(), document.size(), DigitCalibrationValue);
+	}
+
+	// Part 2: first and last digit or spelled-out number of every line
+	template<typename Matcher = EnglishDigitMatcher>
+	static uint64_t SumSpelledValues(std::string_view document)
+	{
+		return SumLines(document.data(), document.size(), Matcher::CalibrationValue);
+	}
+
+	// Both parts over a whole document, split into chunks that are summed on the pool. Chunk i holds every line that
+	// starts inside [i * chunkSize, (i + 1) * chunkSize), so the chunks never need to be found up front and a line is
+	// never cut in two
+	template<typename Matcher = EnglishDigitMatcher>
+	static Day1Sums SumParallel(std::string_view document, ThreadPool& pool, size_t chunkSize = DEFAULT_CHUNK_SIZE)
+	{
+		chunkSize = std::max<size_t>(chunkSize, 1);
+		size_t chunkCount = (document.size() + chunkSize - 1) / chunkSize;
+
+		std::vector<Day1Sums> chunkSums(chunkCount);
+		pool.ParallelFor(chunkCount, [&](size_t i)
+		{
+			size_t begin = NextLineStart(document, i * chunkSize);
+			size_t end = NextLineStart(document, std::min((i + 1) * chunkSize, document.size()));
+			std::string_view chunk = document.substr(begin, end - begin);
+
+			chunkSums[i].digits = SumDigitValues(chunk);
+			chunkSums[i].spelled = SumSpelledValues<Matcher>(chunk);
+		}, "Day1 chunk");
+
+		Day1Sums sums;
+		for (const auto& chunk : chunkSums)
+		{
+			sums.digits += chunk.digits;
+			sums.spelled += chunk.spelled;
+		}
+
+		return sums;
+	}
+
+	// Maps the file rather than reading it, so documents much bigger than memory work too
+	template<typename Matcher = EnglishDigitMatcher>
+	static bool SumFile(const std::string& path, ThreadPool& pool, Day1Sums& out_sums)
+	{
+		MappedFile file;
+		if (!file.Open(path))
+		{
+			return false;
+		}
+
+		out_sums = SumParallel<Matcher>(file.GetView(), pool);
+		return true;
+	}
+
+private:
+
+	// Start of the first line that begins at or after position
+	static size_t NextLineStart(std::string_view document, size_t position)
+	{
+		if (position == 0 || position >= document.size())
+		{
+			return std::min(position, document.size());
+		}
+
+		size_t newline = document.find('\n', position - 1);
+		return newline == std::string_view::npos ? document.size() : newline + 1;
+	}
+};
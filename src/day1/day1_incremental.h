@@ -0,0 +1,287 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "../output.h"
+#include "day1_engine.h"
+
+// Tells two files apart even when they have the same path, like a log and the new file that replaced it
+struct FileIdentity
+{
+	uint64_t device = 0;
+	uint64_t file = 0;
+
+	bool operator==(const FileIdentity& other) const { return device == other.device && file == other.file; }
+	bool operator!=(const FileIdentity& other) const { return !(*this == other); }
+};
+
+inline bool GetFileIdentity(const std::string& path, FileIdentity& out_identity)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	BY_HANDLE_FILE_INFORMATION info;
+	bool found = GetFileInformationByHandle(file, &info) != 0;
+	CloseHandle(file);
+	if (!found)
+	{
+		return false;
+	}
+
+	out_identity.device = info.dwVolumeSerialNumber;
+	out_identity.file = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+#else
+	struct stat fileStat;
+	if (stat(path.c_str(), &fileStat) != 0)
+	{
+		return false;
+	}
+
+	out_identity.device = static_cast<uint64_t>(fileStat.st_dev);
+	out_identity.file = static_cast<uint64_t>(fileStat.st_ino);
+#endif
+	return true;
+}
+
+// Keeps running Day 1 sums for a calibration log that only ever grows by appending. The byte offset of the first line
+// that hasn't been counted yet is stored next to the sums in a small state file, so every update (in this process or a
+// later one) only reads what was appended since the last one.
+//
+// Only complete lines are counted. A line that's still being written (no '\n' yet) is kept in memory and picked up by
+// the update that sees its terminator, so each line is counted exactly once, and each update only reads and searches
+// the bytes appended since the last one, however many appends a long line takes.
+//
+// The log's device and inode (volume and file index on Windows) are stored too. If they change the log was rotated or
+// replaced, and if it shrinks below the stored offset it was truncated; either way counting starts over from the
+// beginning
+class Day1IncrementalAggregator
+{
+public:
+
+	typedef std::function<void(const Day1Sums& sums, uint64_t newLines)> UpdateCallback;
+
+	static constexpr size_t READ_BLOCK_SIZE = 1 << 20;
+
+	Day1IncrementalAggregator(const std::string& _logPath, const std::string& _statePath) : logPath(_logPath), statePath(_statePath)
+	{
+		LoadState();
+	}
+
+	const Day1Sums& GetSums() const { return sums; }
+	uint64_t GetOffset() const { return offset; }
+	uint64_t GetLineCount() const { return lineCount; }
+
+	// Counts every complete line appended since the last update and saves the new state. Returns the number of new
+	// lines, or -1 if the log couldn't be read. A state file that can't be written is reported through Diag(), the
+	// sums in memory are still up to date
+	int64_t Update()
+	{
+		std::ifstream log(logPath, std::ios::in | std::ios::binary);
+		if (!log.good())
+		{
+			return -1;
+		}
+
+		log.seekg(0, std::ios::end);
+		uint64_t logSize = static_cast<uint64_t>(log.tellg());
+
+		bool stateChanged = false;
+		FileIdentity identity;
+		if (GetFileIdentity(logPath, identity))
+		{
+			stateChanged = !hasIdentity || identity != logIdentity;
+			if ((hasIdentity && identity != logIdentity) || logSize < offset + partialLine.size())
+			{
+				Reset();
+				stateChanged = true;
+			}
+
+			logIdentity = identity;
+			hasIdentity = true;
+		}
+		else if (logSize < offset + partialLine.size())
+		{
+			Reset();
+			stateChanged = true;
+		}
+
+		// The bytes of partialLine were already read and have no '\n' in them
+		uint64_t readOffset = offset + partialLine.size();
+		uint64_t newLines = 0;
+		if (logSize > readOffset)
+		{
+			log.seekg(static_cast<std::streamoff>(readOffset), std::ios::beg);
+
+			std::string pending = std::move(partialLine);
+			std::string block(READ_BLOCK_SIZE, '\0');
+			while (log.read(block.data(), block.size()) || log.gcount() > 0)
+			{
+				size_t blockSize = static_cast<size_t>(log.gcount());
+				size_t lastNewline = std::string_view(block.data(), blockSize).rfind('\n');
+				if (lastNewline == std::string_view::npos)
+				{
+					pending.append(block.data(), blockSize);
+					continue;
+				}
+
+				// Everything up to and including the last '\n' is complete, the rest waits for the next block
+				pending.append(block.data(), lastNewline + 1);
+				newLines += CountLines(pending);
+				offset += pending.size();
+				pending.assign(block.data() + lastNewline + 1, blockSize - lastNewline - 1);
+			}
+
+			partialLine = std::move(pending);
+		}
+
+		lineCount += newLines;
+		if ((newLines > 0 || stateChanged) && !SaveState())
+		{
+			Diag() << "[ERROR] Failed to save Day1 state file '" << statePath << "'!" << '\n';
+		}
+
+		return static_cast<int64_t>(newLines);
+	}
+
+	// Tail-follows the log: updates every pollInterval and calls onUpdate whenever new lines came in, until stop is
+	// set. The current sums are published once up front so a consumer starts from the stored total
+	void Follow(std::chrono::milliseconds pollInterval, const UpdateCallback& onUpdate, const std::atomic<bool>& stop)
+	{
+		onUpdate(sums, 0);
+
+		while (!stop.load(std::memory_order_relaxed))
+		{
+			int64_t newLines = Update();
+			if (newLines > 0)
+			{
+				onUpdate(sums, static_cast<uint64_t>(newLines));
+			}
+
+			std::this_thread::sleep_for(pollInterval);
+		}
+	}
+
+	void Reset()
+	{
+		partialLine.clear();
+		offset = 0;
+		lineCount = 0;
+		sums = Day1Sums();
+	}
+
+private:
+
+	uint64_t CountLines(std::string_view completeLines)
+	{
+		uint64_t lines = 0;
+		sums.digits += Day1Engine::SumLines(completeLines.data(), completeLines.size(), [&lines](const char* begin, const char* end)
+		{
+			lines++;
+			return DigitCalibrationValue(begin, end);
+		});
+		sums.spelled += Day1Engine::SumSpelledValues(completeLines);
+		return lines;
+	}
+
+	// State file: a header line, then "offset<TAB>lines<TAB>part 1 sum<TAB>part 2 sum<TAB>device<TAB>file". A missing
+	// or unreadable file just means starting from the beginning of the log. A v1 file has no identity, the log's
+	// current one is adopted on the next update
+	void LoadState()
+	{
+		Reset();
+
+		std::ifstream file(statePath);
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if (line.empty() || line[0] == '#') continue;
+
+			std::istringstream fields(line);
+			Day1Sums loadedSums;
+			uint64_t loadedOffset = 0;
+			uint64_t loadedLines = 0;
+			if (fields >> loadedOffset >> loadedLines >> loadedSums.digits >> loadedSums.spelled)
+			{
+				offset = loadedOffset;
+				lineCount = loadedLines;
+				sums = loadedSums;
+
+				FileIdentity loadedIdentity;
+				if (fields >> loadedIdentity.device >> loadedIdentity.file)
+				{
+					logIdentity = loadedIdentity;
+					hasIdentity = true;
+				}
+			}
+			break;
+		}
+	}
+
+	// Written to a temporary file first and renamed over the old one, so a crash never leaves a half-written state.
+	// Returns false if the state couldn't be written
+	bool SaveState() const
+	{
+		std::string temporaryPath = statePath + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::out | std::ios::trunc);
+			if (!file.good())
+			{
+				return false;
+			}
+
+			file << STATE_HEADER << '\n';
+			file << offset << '\t' << lineCount << '\t' << sums.digits << '\t' << sums.spelled;
+			if (hasIdentity)
+			{
+				file << '\t' << logIdentity.device << '\t' << logIdentity.file;
+			}
+			file << '\n';
+			if (!file.good())
+			{
+				return false;
+			}
+		}
+
+#if defined(_WIN32)
+		// rename() won't replace an existing file on Windows
+		std::remove(statePath.c_str());
+#endif
+		return std::rename(temporaryPath.c_str(), statePath.c_str()) == 0;
+	}
+
+	static constexpr const char* STATE_HEADER = "# AdventOfCode-2023 Day1 incremental state v2 (offset, lines, part 1 sum, part 2 sum, device, file)";
+
+	std::string logPath;
+	std::string statePath;
+
+	uint64_t offset = 0;
+	uint64_t lineCount = 0;
+	Day1Sums sums;
+
+	FileIdentity logIdentity;
+	bool hasIdentity = false;
+
+	// Bytes from offset on that were already read but don't end in '\n' yet. Not saved, a new process reads them again
+	std::string partialLine;
+};
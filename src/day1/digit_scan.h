@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define AOC_DIGIT_SCAN_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_DIGIT_SCAN_WIDTH 16
+#else
+#define AOC_DIGIT_SCAN_WIDTH 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Vectorized search for the first and last ASCII digit of a line. Both scans stop at the first block that contains a
+// digit, so a typical calibration line only ever touches one block from each end
+
+inline bool IsDigitChar(char character)
+{
+	return static_cast<unsigned char>(character - '0') < 10;
+}
+
+inline uint32_t LowestSetBit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+}
+
+inline uint32_t HighestSetBit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse(&index, mask);
+	return index;
+#else
+	return 31u - static_cast<uint32_t>(__builtin_clz(mask));
+#endif
+}
+
+#if AOC_DIGIT_SCAN_WIDTH > 0
+
+// One bit per byte of the block, set where the byte is '0'-'9'. Adding (0x80 - '0') moves the digits to the very bottom
+// of the signed byte range, so a single signed compare against (-128 + 10) picks them out
+inline uint32_t DigitMask(const char* block)
+{
+#if AOC_DIGIT_SCAN_WIDTH == 32
+	const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - '0'));
+	const __m256i limit = _mm256_set1_epi8(static_cast<char>(0x80 + 10));
+	__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+	__m256i isDigit = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(bytes, bias));
+	return static_cast<uint32_t>(_mm256_movemask_epi8(isDigit));
+#else
+	const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - '0'));
+	const __m128i limit = _mm_set1_epi8(static_cast<char>(0x80 + 10));
+	__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+	__m128i isDigit = _mm_cmplt_epi8(_mm_add_epi8(bytes, bias), limit);
+	return static_cast<uint32_t>(_mm_movemask_epi8(isDigit));
+#endif
+}
+
+#endif
+
+// Returns the position of the first digit in [begin, end), or end if there is none
+inline const char* FindFirstDigit(const char* begin, const char* end)
+{
+	const char* current = begin;
+
+#if AOC_DIGIT_SCAN_WIDTH > 0
+	while (end - current >= AOC_DIGIT_SCAN_WIDTH)
+	{
+		uint32_t mask = DigitMask(current);
+		if (mask != 0)
+		{
+			return current + LowestSetBit(mask);
+		}
+		current += AOC_DIGIT_SCAN_WIDTH;
+	}
+#endif
+
+	for (; current != end; current++)
+	{
+		if (IsDigitChar(*current)) return current;
+	}
+
+	return end;
+}
+
+// Returns the position of the last digit in [begin, end), or end if there is none
+inline const char* FindLastDigit(const char* begin, const char* end)
+{
+	const char* current = end;
+
+#if AOC_DIGIT_SCAN_WIDTH > 0
+	while (current - begin >= AOC_DIGIT_SCAN_WIDTH)
+	{
+		uint32_t mask = DigitMask(current - AOC_DIGIT_SCAN_WIDTH);
+		if (mask != 0)
+		{
+			return current - AOC_DIGIT_SCAN_WIDTH + HighestSetBit(mask);
+		}
+		current -= AOC_DIGIT_SCAN_WIDTH;
+	}
+#endif
+
+	while (current != begin)
+	{
+		current--;
+		if (IsDigitChar(*current)) return current;
+	}
+
+	return end;
+}
+
+// First digit * 10 + last digit of a line, or 0 for a line without digits (such as the empty trailing line)
+inline uint32_t DigitCalibrationValue(const char* begin, const char* end)
+{
+	const char* first = FindFirstDigit(begin, end);
+	if (first == end)
+	{
+		return 0;
+	}
+
+	// The backwards scan can stop at the first digit, which is the last digit too if nothing comes after it
+	const char* last = FindLastDigit(first, end);
+	return static_cast<uint32_t>(*first - '0') * 10 + static_cast<uint32_t>(*last - '0');
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string_view>
+
+// Number word vocabularies for part 2. They're constexpr so that the matcher's transition tables can be generated from
+// them at compile time, see word_matcher.h. Words are matched byte for byte, so anything outside ASCII is UTF-8
+
+struct NumberWord
+{
+	std::string_view text;
+	int value;
+};
+
+inline constexpr NumberWord ENGLISH_NUMBER_WORDS[] =
+{
+	{ "one", 1 },
+	{ "two", 2 },
+	{ "three", 3 },
+	{ "four", 4 },
+	{ "five", 5 },
+	{ "six", 6 },
+	{ "seven", 7 },
+	{ "eight", 8 },
+	{ "nine", 9 },
+};
+
+inline constexpr NumberWord SPANISH_NUMBER_WORDS[] =
+{
+	{ "uno", 1 },
+	{ "dos", 2 },
+	{ "tres", 3 },
+	{ "cuatro", 4 },
+	{ "cinco", 5 },
+	{ "seis", 6 },
+	{ "siete", 7 },
+	{ "ocho", 8 },
+	{ "nueve", 9 },
+};
+
+inline constexpr NumberWord GERMAN_NUMBER_WORDS[] =
+{
+	{ "eins", 1 },
+	{ "zwei", 2 },
+	{ "drei", 3 },
+	{ "vier", 4 },
+	{ "f\xC3\xBCnf", 5 },
+	{ "sechs", 6 },
+	{ "sieben", 7 },
+	{ "acht", 8 },
+	{ "neun", 9 },
+};
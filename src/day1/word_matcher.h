@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "number_words.h"
+
+// Aho-Corasick automaton over the digits '0'-'9' plus a vocabulary of number words, compiled into a full DFA so that
+// every byte of the line costs one table lookup and overlapping words like "twone" or "eightwo" are all seen. The
+// tables are generated at compile time from the constexpr vocabularies in number_words.h, so there's no setup at
+// startup and no hashing while matching
+
+static constexpr int8_t NO_DIGIT_MATCH = -1;
+
+template<size_t StateCount, size_t ClassCount>
+struct DigitTransitionTable
+{
+	// Bytes that don't appear in any word all share class 0, which keeps the table small
+	uint8_t classes[256] = {};
+	uint16_t transitions[StateCount][ClassCount] = {};
+	int8_t outputs[StateCount] = {};
+
+	// Value of the first word or digit found while feeding the bytes from begin towards end (begin > end walks
+	// backwards, which is how the tables built over reversed words are used), or NO_DIGIT_MATCH
+	constexpr int Find(const char* begin, const char* end) const
+	{
+		int step = begin < end ? 1 : -1;
+		int offset = begin < end ? 0 : -1;
+
+		uint16_t state = 0;
+		for (const char* current = begin; current != end; current += step)
+		{
+			state = transitions[state][classes[static_cast<uint8_t>(current[offset])]];
+			if (outputs[state] != NO_DIGIT_MATCH)
+			{
+				return outputs[state];
+			}
+		}
+
+		return NO_DIGIT_MATCH;
+	}
+};
+
+// Every digit and word is a pattern, patterns are numbered digits first
+template<const auto& Words>
+struct DigitPatterns
+{
+	static constexpr size_t COUNT = 10 + sizeof(Words) / sizeof(Words[0]);
+
+	static constexpr std::string_view GetText(size_t pattern)
+	{
+		constexpr std::string_view DIGITS = "0123456789";
+		return pattern < 10 ? DIGITS.substr(pattern, 1) : Words[pattern - 10].text;
+	}
+
+	static constexpr int GetValue(size_t pattern)
+	{
+		return pattern < 10 ? static_cast<int>(pattern) : Words[pattern - 10].value;
+	}
+
+	// The trie can't have more states than the patterns have bytes, plus the root
+	static constexpr size_t CountStates()
+	{
+		size_t states = 1;
+		for (size_t pattern = 0; pattern < COUNT; pattern++) states += GetText(pattern).size();
+		return states;
+	}
+
+	static constexpr size_t CountClasses()
+	{
+		bool used[256] = {};
+		size_t classes = 1;
+		for (size_t pattern = 0; pattern < COUNT; pattern++)
+		{
+			for (auto character : GetText(pattern))
+			{
+				uint8_t byte = static_cast<uint8_t>(character);
+				if (!used[byte])
+				{
+					used[byte] = true;
+					classes++;
+				}
+			}
+		}
+		return classes;
+	}
+};
+
+template<const auto& Words, bool Reversed>
+constexpr auto BuildDigitTransitionTable()
+{
+	typedef DigitPatterns<Words> Patterns;
+	constexpr size_t STATES = Patterns::CountStates();
+	constexpr size_t CLASSES = Patterns::CountClasses();
+	static_assert(STATES <= 65536, "Vocabulary too big for 16-bit states");
+
+	DigitTransitionTable<STATES, CLASSES> table;
+
+	uint8_t classCount = 1;
+	for (size_t pattern = 0; pattern < Patterns::COUNT; pattern++)
+	{
+		for (auto character : Patterns::GetText(pattern))
+		{
+			uint8_t byte = static_cast<uint8_t>(character);
+			if (table.classes[byte] == 0) table.classes[byte] = classCount++;
+		}
+	}
+
+	// Trie first. State 0 is the root, so an edge that points at 0 doesn't exist yet
+	size_t stateCount = 1;
+	for (size_t state = 0; state < STATES; state++) table.outputs[state] = NO_DIGIT_MATCH;
+
+	for (size_t pattern = 0; pattern < Patterns::COUNT; pattern++)
+	{
+		std::string_view text = Patterns::GetText(pattern);
+
+		uint16_t state = 0;
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			char character = Reversed ? text[text.size() - 1 - i] : text[i];
+			uint16_t& next = table.transitions[state][table.classes[static_cast<uint8_t>(character)]];
+			if (next == 0)
+			{
+				next = static_cast<uint16_t>(stateCount++);
+			}
+			state = next;
+		}
+		table.outputs[state] = static_cast<int8_t>(Patterns::GetValue(pattern));
+	}
+
+	// Then fill in the missing edges breadth-first from the failure links. A state that has no word of its own
+	// reports the word of its failure state, which is the longest word ending at the same position
+	uint16_t failure[STATES] = {};
+	uint16_t pending[STATES] = {};
+	size_t pendingBegin = 0;
+	size_t pendingEnd = 0;
+	for (size_t byteClass = 0; byteClass < CLASSES; byteClass++)
+	{
+		if (table.transitions[0][byteClass] != 0)
+		{
+			pending[pendingEnd++] = table.transitions[0][byteClass];
+		}
+	}
+
+	while (pendingBegin != pendingEnd)
+	{
+		uint16_t state = pending[pendingBegin++];
+
+		if (table.outputs[state] == NO_DIGIT_MATCH)
+		{
+			table.outputs[state] = table.outputs[failure[state]];
+		}
+
+		for (size_t byteClass = 0; byteClass < CLASSES; byteClass++)
+		{
+			uint16_t& next = table.transitions[state][byteClass];
+			uint16_t fallback = table.transitions[failure[state]][byteClass];
+			if (next == 0)
+			{
+				next = fallback;
+			}
+			else
+			{
+				failure[next] = fallback;
+				pending[pendingEnd++] = next;
+			}
+		}
+	}
+
+	return table;
+}
+
+// Finds the first match with a forward automaton and the last one with a reverse automaton run from the end of the
+// line, so neither scan goes further into the line than it needs to
+template<const auto& Words>
+class SpelledDigitMatcher
+{
+public:
+
+	static constexpr auto FORWARD = BuildDigitTransitionTable<Words, false>();
+	static constexpr auto BACKWARD = BuildDigitTransitionTable<Words, true>();
+
+	// First value * 10 + last value of a line, or 0 for a line without any
+	static constexpr uint32_t CalibrationValue(const char* begin, const char* end)
+	{
+		int first = FORWARD.Find(begin, end);
+		if (first == NO_DIGIT_MATCH)
+		{
+			return 0;
+		}
+
+		int last = BACKWARD.Find(end, begin);
+		return static_cast<uint32_t>(first * 10 + last);
+	}
+};
+
+typedef SpelledDigitMatcher<ENGLISH_NUMBER_WORDS> EnglishDigitMatcher;
+typedef SpelledDigitMatcher<SPANISH_NUMBER_WORDS> SpanishDigitMatcher;
+typedef SpelledDigitMatcher<GERMAN_NUMBER_WORDS> GermanDigitMatcher;
+
+static_assert(EnglishDigitMatcher::CalibrationValue("xtwone3four", "xtwone3four" + 11) == 24, "English matcher");
+static_assert(EnglishDigitMatcher::CalibrationValue("eightwo", "eightwo" + 7) == 82, "Overlapping words");
@@ -94,8 +94,11 @@
 
 
 #include "../challenge.h"
+#include "../output.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
 #include <numeric>
 #include <optional>
 #include <unordered_map>
@@ -376,8 +379,8 @@ struct Day10_1 : public Challenge
 		// We now have a closed loop, calculate furthest tile (mid-point)
 		size_t stepsToFurthestTile = std::ceil(maze.size() / 2);
 
-		std::cout << "Maze size: " << maze.size() << " | Steps to furthest tile: " << stepsToFurthestTile << std::endl;
-		std::cout << "Actual result: " << stepsToFurthestTile << std::endl;
+		Diag() << "Maze size: " << maze.size() << " | Steps to furthest tile: " << stepsToFurthestTile << '\n';
+		Diag() << "Actual result: " << stepsToFurthestTile << '\n';
 
 		return stepsToFurthestTile;
 	}
@@ -582,7 +585,7 @@ struct Day10_2 : public Challenge
 	{
 		for (const auto& line : *input)
 		{
-			std::cout << line << std::endl;
+			Diag() << line << '\n';
 		}
 	}
 
@@ -769,7 +772,7 @@ struct Day10_2 : public Challenge
 			prevTile = currTile;
 		}
 
-		std::cout << "\n\n Flood fill using separating axis\n\n";
+		Diag() << "\n\n Flood fill using separating axis\n\n";
 		PrintInput(&input);
 
 		// Count up anything marked as 'I'
@@ -785,7 +788,7 @@ struct Day10_2 : public Challenge
 			}
 		}
 
-		std::cout << "\n\nInternal tiles found: " << internalTiles << std::endl;;
+		Diag() << "\n\nInternal tiles found: " << internalTiles << '\n';
 
 		return internalTiles;
 	}
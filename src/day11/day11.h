@@ -1,5 +1,6 @@
 
 #include "../challenge.h"
+#include "../output.h"
 
 #include <algorithm>
 #include <unordered_map>
@@ -9,12 +10,12 @@ struct Day11_1 : public Challenge
 {
 	void PrintInput(Input& input)
 	{
-		std::cout << "\n\n";
+		Diag() << "\n\n";
 		for (const auto& line : input)
 		{
-			std::cout << line.c_str() << std::endl;
+			Diag() << line.c_str() << '\n';
 		}
-		std::cout << "\n\n";
+		Diag() << "\n\n";
 	}
 
 	void BresenhamLow(std::pair<int, int> p1, std::pair<int, int> p2, int& steps, Input& input)
@@ -79,7 +80,7 @@ struct Day11_1 : public Challenge
 
 	int Run(Input input)
 	{
-		std::cout << '\n';
+		Diag() << '\n';
 		//PrintInput(input);
 
 		// Detect empty rows
@@ -224,7 +225,7 @@ struct Day11_1 : public Challenge
 			distanceSum += stepsTaken;
 		}
 
-		std::cout << "Actual result: " << distanceSum << std::endl;
+		Diag() << "Actual result: " << distanceSum << '\n';
 
 		return distanceSum;
 	}
@@ -236,12 +237,12 @@ struct Day11_2 : public Challenge
 {
 	void PrintInput(Input& input)
 	{
-		std::cout << "\n\n";
+		Diag() << "\n\n";
 		for (const auto& line : input)
 		{
-			std::cout << line.c_str() << std::endl;
+			Diag() << line.c_str() << '\n';
 		}
-		std::cout << "\n\n";
+		Diag() << "\n\n";
 	}
 
 	void BresenhamLow(std::pair<int, int> p1, std::pair<int, int> p2, int& steps, Input& input)
@@ -341,7 +342,7 @@ struct Day11_2 : public Challenge
 
 	int Run(Input input)
 	{
-		std::cout << '\n';
+		Diag() << '\n';
 		PrintInput(input);
 
 		// Detect empty rows
@@ -490,11 +491,11 @@ struct Day11_2 : public Challenge
 
 			PrintInput(inputCopy);
 
-			std::cout << "Distance between (" << p1.first << ", " << p1.second << ") and (" << p2.first << ", " << p2.second << ") is " << stepsTaken << std::endl;
+			Diag() << "Distance between (" << p1.first << ", " << p1.second << ") and (" << p2.first << ", " << p2.second << ") is " << stepsTaken << '\n';
 			distanceSum += stepsTaken;
 		}
 
-		std::cout << "Actual result: " << distanceSum << std::endl;
+		Diag() << "Actual result: " << distanceSum << '\n';
 
 		return distanceSum;
 	}
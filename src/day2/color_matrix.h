@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "color_schema.h"
+#include "game_store.h"
+
+// GameMaximaStore for any number of colors: a dense games x colors matrix of per-game maxima, stored one column per
+// color id so that the kernels stream through each column with SIMD. A color that first shows up late gets a column
+// of zeros for all the games before it. Maxima are full 32-bit counts like in GameMaximaStore
+class GameColorMatrix
+{
+public:
+
+	ColorSchema& GetSchema() { return schema; }
+	const ColorSchema& GetSchema() const { return schema; }
+
+	size_t GetGameCount() const { return ids.size(); }
+	size_t GetColorCount() const { return columns.size(); }
+	uint32_t GetID(size_t game) const { return ids[game]; }
+	uint32_t GetMaximum(size_t game, uint16_t color) const { return columns[color][game]; }
+
+	// Parses a record with any color names and appends its maxima. Lines that aren't game records are skipped
+	bool AddRecord(std::string_view line)
+	{
+		uint32_t id = 0;
+		std::fill(row.begin(), row.end(), 0);
+		bool parsed = ParseGameRecordColors(line, schema, id, [this](uint16_t color, uint32_t count)
+		{
+			if (color >= row.size()) row.resize(color + 1, 0);
+			row[color] = std::max(row[color], count);
+		});
+
+		if (!parsed)
+		{
+			return false;
+		}
+
+		while (columns.size() < schema.GetColorCount())
+		{
+			columns.emplace_back(ids.size(), 0);
+		}
+
+		ids.push_back(id);
+		for (size_t color = 0; color < columns.size(); color++)
+		{
+			columns[color].push_back(color < row.size() ? row[color] : 0);
+		}
+		return true;
+	}
+
+	// Part 1 for any colors: limits are indexed by color id (see ColorSchema::MakeLimits), and a color without a limit
+	// is treated as having none of its cubes in the bag
+	uint64_t SumPossibleIDs(const std::vector<uint32_t>& limits) const
+	{
+		std::vector<uint32_t> colorLimits(columns.size(), 0);
+		for (size_t color = 0; color < columns.size() && color < limits.size(); color++)
+		{
+			colorLimits[color] = limits[color];
+		}
+
+		size_t gameCount = ids.size();
+		uint64_t sum = 0;
+		size_t game = 0;
+
+#if defined(__AVX2__)
+		__m256i sums = _mm256_setzero_si256();
+		for (; game + 8 <= gameCount; game += 8)
+		{
+			// count <= limit exactly when max(count, limit) == limit
+			__m256i possible = _mm256_set1_epi32(-1);
+			for (size_t color = 0; color < columns.size(); color++)
+			{
+				__m256i counts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&columns[color][game]));
+				__m256i limit = _mm256_set1_epi32(static_cast<int>(colorLimits[color]));
+				possible = _mm256_and_si256(possible, _mm256_cmpeq_epi32(_mm256_max_epu32(counts, limit), limit));
+			}
+
+			__m256i gameIDs = _mm256_and_si256(possible, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ids[game])));
+			sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(gameIDs)));
+			sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(gameIDs, 1)));
+		}
+		sum += HorizontalSum(sums);
+#elif AOC_GAME_STORE_SSE2
+		// Signed compares with the sign bit flipped on both sides are unsigned compares
+		const __m128i signBit = _mm_set1_epi32(INT32_MIN);
+		const __m128i zero = _mm_setzero_si128();
+		__m128i sums = _mm_setzero_si128();
+		for (; game + 4 <= gameCount; game += 4)
+		{
+			__m128i impossible = _mm_setzero_si128();
+			for (size_t color = 0; color < columns.size(); color++)
+			{
+				__m128i counts = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&columns[color][game])), signBit);
+				__m128i limit = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(colorLimits[color])), signBit);
+				impossible = _mm_or_si128(impossible, _mm_cmpgt_epi32(counts, limit));
+			}
+
+			__m128i gameIDs = _mm_andnot_si128(impossible, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ids[game])));
+			sums = _mm_add_epi64(sums, _mm_add_epi64(_mm_unpacklo_epi32(gameIDs, zero), _mm_unpackhi_epi32(gameIDs, zero)));
+		}
+		sum += HorizontalSum(sums);
+#endif
+
+		for (; game < gameCount; game++)
+		{
+			bool possible = true;
+			for (size_t color = 0; color < columns.size(); color++)
+			{
+				possible &= columns[color][game] <= colorLimits[color];
+			}
+			if (possible) sum += ids[game];
+		}
+
+		return sum;
+	}
+
+	// Part 2 for any colors: sum over the games of the product of every color's maximum. Products are exact up to 64
+	// bits and wrap beyond that
+	uint64_t SumPowers() const
+	{
+		if (columns.empty())
+		{
+			return 0;
+		}
+
+		size_t gameCount = ids.size();
+		uint64_t sum = 0;
+		size_t game = 0;
+
+#if defined(__AVX2__)
+		const __m256i one = _mm256_set1_epi64x(1);
+		__m256i sums = _mm256_setzero_si256();
+		for (; game + 8 <= gameCount; game += 8)
+		{
+			__m256i products[2] = { one, one };
+			for (const auto& column : columns)
+			{
+				__m256i counts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&column[game]));
+				products[0] = MultiplyU64(products[0], _mm256_cvtepu32_epi64(_mm256_castsi256_si128(counts)));
+				products[1] = MultiplyU64(products[1], _mm256_cvtepu32_epi64(_mm256_extracti128_si256(counts, 1)));
+			}
+			sums = _mm256_add_epi64(sums, _mm256_add_epi64(products[0], products[1]));
+		}
+		sum += HorizontalSum(sums);
+#elif AOC_GAME_STORE_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i one = _mm_set_epi32(0, 1, 0, 1);
+		__m128i sums = _mm_setzero_si128();
+		for (; game + 4 <= gameCount; game += 4)
+		{
+			__m128i products[2] = { one, one };
+			for (const auto& column : columns)
+			{
+				__m128i counts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&column[game]));
+				products[0] = MultiplyU64(products[0], _mm_unpacklo_epi32(counts, zero));
+				products[1] = MultiplyU64(products[1], _mm_unpackhi_epi32(counts, zero));
+			}
+			sums = _mm_add_epi64(sums, _mm_add_epi64(products[0], products[1]));
+		}
+		sum += HorizontalSum(sums);
+#endif
+
+		for (; game < gameCount; game++)
+		{
+			uint64_t product = 1;
+			for (const auto& column : columns)
+			{
+				product *= column[game];
+			}
+			sum += product;
+		}
+
+		return sum;
+	}
+
+private:
+
+	// 64-bit lanes times values that fit in 32 bits, from two 32x32 -> 64 multiplies of the low and high halves
+#if defined(__AVX2__)
+	static __m256i MultiplyU64(__m256i values, __m256i factors)
+	{
+		__m256i low = _mm256_mul_epu32(values, factors);
+		__m256i high = _mm256_mul_epu32(_mm256_srli_epi64(values, 32), factors);
+		return _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+	}
+
+	static uint64_t HorizontalSum(__m256i values)
+	{
+		alignas(32) uint64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), values);
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+#elif AOC_GAME_STORE_SSE2
+	static __m128i MultiplyU64(__m128i values, __m128i factors)
+	{
+		__m128i low = _mm_mul_epu32(values, factors);
+		__m128i high = _mm_mul_epu32(_mm_srli_epi64(values, 32), factors);
+		return _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+	}
+
+	static uint64_t HorizontalSum(__m128i values)
+	{
+		alignas(16) uint64_t lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), values);
+		return lanes[0] + lanes[1];
+	}
+#endif
+
+	ColorSchema schema;
+
+	std::vector<uint32_t, AlignedAllocator<uint32_t>> ids;
+	std::vector<std::vector<uint32_t, AlignedAllocator<uint32_t>>> columns;
+
+	// Scratch maxima for the record being parsed, kept around so parsing doesn't allocate once the colors are known
+	std::vector<uint32_t> row;
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Colors are whatever names show up in the records. Each new name gets the next small integer id the first time it's
+// seen, and everything after parsing works on ids only. Games rarely have more than a handful of colors, so a linear
+// search over the names beats hashing and needs no allocation per lookup
+class ColorSchema
+{
+public:
+
+	static constexpr uint16_t INVALID_COLOR = UINT16_MAX;
+
+	// Returns INVALID_COLOR for a new name once every id is taken, rather than wrapping around onto an existing color
+	uint16_t Intern(std::string_view name)
+	{
+		uint16_t color = Find(name);
+		if (color == INVALID_COLOR && names.size() < INVALID_COLOR)
+		{
+			color = static_cast<uint16_t>(names.size());
+			names.emplace_back(name);
+		}
+		return color;
+	}
+
+	uint16_t Find(std::string_view name) const
+	{
+		for (size_t color = 0; color < names.size(); color++)
+		{
+			if (names[color] == name) return static_cast<uint16_t>(color);
+		}
+		return INVALID_COLOR;
+	}
+
+	const std::string& GetName(uint16_t color) const { return names[color]; }
+	size_t GetColorCount() const { return names.size(); }
+
+	// Per-color limits indexed by color id, for the given (name, limit) pairs. Colors that aren't mentioned get a limit
+	// of 0, since a bag without any cubes of a color can't produce one. Names that can't be interned anymore are left
+	// out: no record can have them either
+	std::vector<uint32_t> MakeLimits(const std::vector<std::pair<std::string, uint32_t>>& namedLimits)
+	{
+		for (const auto& namedLimit : namedLimits)
+		{
+			Intern(namedLimit.first);
+		}
+
+		std::vector<uint32_t> limits(names.size(), 0);
+		for (const auto& namedLimit : namedLimits)
+		{
+			uint16_t color = Find(namedLimit.first);
+			if (color != INVALID_COLOR) limits[color] = namedLimit.second;
+		}
+		return limits;
+	}
+
+private:
+
+	std::vector<std::string> names;
+};
+
+// Same single pass state machine as ParseGameRecord, but for records with any color names. Every "<count> <color>" is
+// handed to onCubes(colorID, count) with the name interned into the schema; the draw boundaries are skipped, since
+// both questions only depend on the per-game maxima. A record with a new color once the schema is full isn't valid
+template<typename CubesHandler>
+bool ParseGameRecordColors(std::string_view line, ColorSchema& schema, uint32_t& out_id, CubesHandler&& onCubes)
+{
+	static constexpr std::string_view PREFIX = "Game ";
+	if (line.substr(0, PREFIX.size()) != PREFIX)
+	{
+		return false;
+	}
+
+	enum class State
+	{
+		ID,
+		BEFORE_COUNT,
+		COUNT,
+		BEFORE_COLOR,
+		COLOR,
+		AFTER_COLOR,
+	};
+
+	State state = State::ID;
+	uint32_t id = 0;
+	uint32_t count = 0;
+	size_t colorStart = 0;
+	bool hasID = false;
+
+	for (size_t i = PREFIX.size(); i <= line.size(); i++)
+	{
+		// One extra iteration with a virtual separator, so a color name that ends the line is finished like any other
+		char c = i < line.size() ? line[i] : ';';
+		bool isDigit = static_cast<unsigned char>(c - '0') < 10;
+
+		switch (state)
+		{
+		case State::ID:
+			if (isDigit)
+			{
+				id = id * 10 + static_cast<uint32_t>(c - '0');
+				hasID = true;
+			}
+			else if (c == ':' && hasID)
+			{
+				state = State::BEFORE_COUNT;
+			}
+			else
+			{
+				return false;
+			}
+			break;
+
+		case State::BEFORE_COUNT:
+			if (isDigit)
+			{
+				count = static_cast<uint32_t>(c - '0');
+				state = State::COUNT;
+			}
+			else if (c != ' ')
+			{
+				return false;
+			}
+			break;
+
+		case State::COUNT:
+			if (isDigit)
+			{
+				count = count * 10 + static_cast<uint32_t>(c - '0');
+			}
+			else if (c == ' ')
+			{
+				state = State::BEFORE_COLOR;
+			}
+			else
+			{
+				return false;
+			}
+			break;
+
+		case State::BEFORE_COLOR:
+			if (c == ' ') break;
+			if (c == ',' || c == ';') return false;
+
+			colorStart = i;
+			state = State::COLOR;
+			break;
+
+		case State::COLOR:
+			if (c == ',' || c == ';' || c == ' ' || c == '\r')
+			{
+				uint16_t color = schema.Intern(line.substr(colorStart, i - colorStart));
+				if (color == ColorSchema::INVALID_COLOR) return false;
+
+				onCubes(color, count);
+				state = (c == ',' || c == ';') ? State::BEFORE_COUNT : State::AFTER_COLOR;
+			}
+			break;
+
+		case State::AFTER_COLOR:
+			if (c == ',' || c == ';')
+			{
+				state = State::BEFORE_COUNT;
+			}
+			else if (c != ' ' && c != '\r')
+			{
+				return false;
+			}
+			break;
+		}
+	}
+
+	// The virtual separator at the end leaves a complete record waiting for its next count
+	if (state != State::BEFORE_COUNT)
+	{
+		return false;
+	}
+
+	out_id = id;
+	return true;
+}
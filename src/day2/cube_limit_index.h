@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../thread_pool.h"
+#include "game_store.h"
+
+// Answers "sum of the ids of the games that are possible with (red, green, blue) cubes" for many different limits
+// against the same games, without going over every game for every question.
+//
+// Each game is a point (red max, green max, blue max), and a query sums the ids of the points it dominates. The points
+// go into a k-d tree split at the median, cycling through red, green and blue, where every node knows its bounding box
+// and the id sum of everything below it: a subtree that lies entirely under the limits is added in one go, one that's
+// entirely over them on any axis is skipped, and only the nodes straddling the query's corner get opened up, which is
+// O(n^(2/3)) nodes per query at worst instead of n games.
+//
+// Real game maxima only take a few distinct values per color though. When the distinct values span a small enough
+// grid, the index is a 3D prefix sum over that grid instead, and a query is three binary searches and one lookup
+class CubeLimitIndex
+{
+public:
+
+	static constexpr uint32_t LEAF_SIZE = 16;
+	static constexpr size_t MAX_GRID_CELLS = 1 << 24;
+
+	CubeLimitIndex(const GameMaximaStore& store)
+	{
+		points.reserve(store.GetGameCount());
+		for (size_t game = 0; game < store.GetGameCount(); game++)
+		{
+			CubeCounts maxima = store.GetMaxima(game);
+			points.push_back({ { maxima.red, maxima.green, maxima.blue }, store.GetID(game) });
+		}
+
+		if (BuildGrid())
+		{
+			return;
+		}
+
+		if (!points.empty())
+		{
+			nodes.reserve(2 * points.size() / LEAF_SIZE + 1);
+			Build(0, static_cast<uint32_t>(points.size()), 0);
+		}
+	}
+
+	uint64_t SumPossibleIDs(const CubeCounts& limits) const
+	{
+		uint32_t limit[3] = { limits.red, limits.green, limits.blue };
+
+		if (!grid.empty())
+		{
+			// Number of distinct values at or under the limit on each axis, which is one past the cell to read
+			size_t cell[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				cell[axis] = std::upper_bound(axisValues[axis].begin(), axisValues[axis].end(), limit[axis]) - axisValues[axis].begin();
+				if (cell[axis] == 0) return 0;
+			}
+
+			return grid[GridIndex(cell[0] - 1, cell[1] - 1, cell[2] - 1)];
+		}
+
+		if (nodes.empty())
+		{
+			return 0;
+		}
+
+		return Query(0, limit);
+	}
+
+	bool IsUsingGrid() const { return !grid.empty(); }
+
+	// Answers a whole batch, spread over the pool. Every answer only depends on its own query, so the results are the
+	// same whatever the thread count
+	std::vector<uint64_t> SumPossibleIDs(const std::vector<CubeCounts>& queries, ThreadPool& pool = ThreadPool::Get()) const
+	{
+		static constexpr size_t QUERIES_PER_TASK = 256;
+
+		std::vector<uint64_t> answers(queries.size());
+		size_t taskCount = (queries.size() + QUERIES_PER_TASK - 1) / QUERIES_PER_TASK;
+		pool.ParallelFor(taskCount, [&](size_t task)
+		{
+			size_t end = std::min(queries.size(), (task + 1) * QUERIES_PER_TASK);
+			for (size_t query = task * QUERIES_PER_TASK; query < end; query++)
+			{
+				answers[query] = SumPossibleIDs(queries[query]);
+			}
+		}, "Day2 queries");
+
+		return answers;
+	}
+
+private:
+
+	struct Point
+	{
+		uint32_t counts[3];
+		uint32_t id;
+	};
+
+	struct Node
+	{
+		uint32_t min[3];
+		uint32_t max[3];
+		uint32_t begin;
+		uint32_t end;
+
+		// Children are only set for inner nodes, leaves are scanned point by point
+		uint32_t left;
+		uint32_t right;
+		uint64_t idSum;
+	};
+
+	bool BuildGrid()
+	{
+		size_t cells = 1;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			std::vector<uint32_t>& values = axisValues[axis];
+			for (const auto& point : points) values.push_back(point.counts[axis]);
+			std::sort(values.begin(), values.end());
+			values.erase(std::unique(values.begin(), values.end()), values.end());
+			cells *= std::max<size_t>(values.size(), 1);
+		}
+
+		if (points.empty() || cells > MAX_GRID_CELLS || cells > points.size() * 8)
+		{
+			for (auto& values : axisValues) values.clear();
+			return false;
+		}
+
+		grid.assign(cells, 0);
+		for (const auto& point : points)
+		{
+			size_t cell[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				cell[axis] = std::lower_bound(axisValues[axis].begin(), axisValues[axis].end(), point.counts[axis]) - axisValues[axis].begin();
+			}
+			grid[GridIndex(cell[0], cell[1], cell[2])] += point.id;
+		}
+
+		// Running sums along each axis in turn make every cell into the sum over the box from the origin up to it
+		size_t sizes[3] = { axisValues[0].size(), axisValues[1].size(), axisValues[2].size() };
+		for (size_t r = 1; r < sizes[0]; r++)
+		{
+			for (size_t g = 0; g < sizes[1]; g++)
+			{
+				for (size_t b = 0; b < sizes[2]; b++)
+				{
+					grid[GridIndex(r, g, b)] += grid[GridIndex(r - 1, g, b)];
+				}
+			}
+		}
+		for (size_t r = 0; r < sizes[0]; r++)
+		{
+			for (size_t g = 1; g < sizes[1]; g++)
+			{
+				for (size_t b = 0; b < sizes[2]; b++)
+				{
+					grid[GridIndex(r, g, b)] += grid[GridIndex(r, g - 1, b)];
+				}
+			}
+		}
+		for (size_t r = 0; r < sizes[0]; r++)
+		{
+			for (size_t g = 0; g < sizes[1]; g++)
+			{
+				for (size_t b = 1; b < sizes[2]; b++)
+				{
+					grid[GridIndex(r, g, b)] += grid[GridIndex(r, g, b - 1)];
+				}
+			}
+		}
+
+		points.clear();
+		points.shrink_to_fit();
+		return true;
+	}
+
+	size_t GridIndex(size_t r, size_t g, size_t b) const
+	{
+		return (r * axisValues[1].size() + g) * axisValues[2].size() + b;
+	}
+
+	uint32_t Build(uint32_t begin, uint32_t end, int depth)
+	{
+		uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+		nodes.push_back({});
+
+		Node node = {};
+		node.begin = begin;
+		node.end = end;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			node.min[axis] = UINT32_MAX;
+			node.max[axis] = 0;
+		}
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				node.min[axis] = std::min(node.min[axis], points[i].counts[axis]);
+				node.max[axis] = std::max(node.max[axis], points[i].counts[axis]);
+			}
+			node.idSum += points[i].id;
+		}
+
+		if (end - begin > LEAF_SIZE)
+		{
+			// Cycling through the axes at the median is what keeps the tree balanced in all three of them, which the
+			// per-query bound relies on
+			int axis = depth % 3;
+
+			uint32_t middle = begin + (end - begin) / 2;
+			std::nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end, [axis](const Point& lhs, const Point& rhs)
+			{
+				return lhs.counts[axis] < rhs.counts[axis];
+			});
+
+			node.left = Build(begin, middle, depth + 1);
+			node.right = Build(middle, end, depth + 1);
+		}
+
+		// Not holding a reference across the recursion, the node array may have grown
+		nodes[nodeIndex] = node;
+		return nodeIndex;
+	}
+
+	uint64_t Query(uint32_t nodeIndex, const uint32_t limit[3]) const
+	{
+		const Node& node = nodes[nodeIndex];
+
+		bool fullyInside = true;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (node.min[axis] > limit[axis]) return 0;
+			if (node.max[axis] > limit[axis]) fullyInside = false;
+		}
+
+		if (fullyInside)
+		{
+			return node.idSum;
+		}
+
+		if (node.end - node.begin <= LEAF_SIZE)
+		{
+			uint64_t sum = 0;
+			for (uint32_t i = node.begin; i < node.end; i++)
+			{
+				const Point& point = points[i];
+				if (point.counts[0] <= limit[0] && point.counts[1] <= limit[1] && point.counts[2] <= limit[2])
+				{
+					sum += point.id;
+				}
+			}
+			return sum;
+		}
+
+		return Query(node.left, limit) + Query(node.right, limit);
+	}
+
+	std::vector<Point> points;
+	std::vector<Node> nodes;
+
+	std::vector<uint32_t> axisValues[3];
+	std::vector<uint64_t> grid;
+};
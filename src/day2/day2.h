@@ -26,211 +26,31 @@
 // 
 // To begin, get your puzzle input
 
-#include <assert.h>
-#include <unordered_map>
-
 #include "../challenge.h"
+#include "../output.h"
+#include "game_parser.h"
+#include "game_store.h"
 
-class Game
-{
-public:
-
-	bool IsPossible(std::string input)
-	{
-		int colonPos = input.find(":");
-
-		std::string id_str = input.substr(5, colonPos - 5);
-		for(const auto c : id_str) assert(std::isdigit(c));
-
-		id = atoi(id_str.c_str());
-		
-		input.erase(0, colonPos + 1);
-
-		// Since the cubes are put back after each draw, then all we care about is if the picked number of cubes of a certain color is greater
-		// than the ones stated in the question (this would make the game impossible)
-		static const std::unordered_map<std::string, int> DRAW_LIMITS =
-		{
-			{ "red", 12 },
-			{ "green", 13 },
-			{ "blue", 14 }
-		};
-
-		std::vector<std::string> draws;
-		char delimiter = ';';
-		int delimiterPos = 0;
-		while ((delimiterPos = input.find(delimiter)) != std::string::npos)
-		{
-			draws.push_back(input.substr(1, delimiterPos));
-			input.erase(0, delimiterPos + 1);
-		}
-
-		// Get the last draw
-		if (!input.empty())
-		{
-			draws.push_back(input.substr(1, input.size()));
-			input.clear();
-		}
-
-		for (const auto draw : draws)
-		{
-			int redPicked = 0;
-			int greenPicked = 0;
-			int bluePicked = 0;
-
-			int number = 0;
-			std::string number_str = "";
-			for (int i = 0; i < draw.size(); i++)
-			{
-				char c = draw[i];
-				if (!std::isdigit(c))
-				{
-					if (!number_str.empty())
-					{
-						number = std::atoi(number_str.c_str());
-						number_str.clear();
-					}
-				}
-
-				if (c == 'r')
-				{
-					redPicked = number;
-					number = 0;
-					i += 3;
-				}
-				else if (c == 'g')
-				{
-					greenPicked = number;
-					number = 0;
-					i += 5;
-				}
-				else if (c == 'b')
-				{
-					bluePicked = number;
-					number = 0;
-					i += 4;
-				}
-				else if (std::isdigit(c))
-				{
-					number_str += c;
-				}
-			}
-
-			if (redPicked > DRAW_LIMITS.at("red") ||
-				greenPicked > DRAW_LIMITS.at("green") ||
-				bluePicked > DRAW_LIMITS.at("blue"))
-			{
-				// Draw is illegal
-				return false;
-			}
-		}
-
-		return true;
-	}
-
-	void MinCubesRequiredToPlay(std::string input, int* redCubes, int* greenCubes, int* blueCubes)
-	{
-		int colonPos = input.find(":");
-
-		std::string id_str = input.substr(5, colonPos - 5);
-		for (const auto c : id_str) assert(std::isdigit(c));
-
-		id = atoi(id_str.c_str());
-
-		input.erase(0, colonPos + 1);
-
-		std::vector<std::string> draws;
-		char delimiter = ';';
-		int delimiterPos = 0;
-		while ((delimiterPos = input.find(delimiter)) != std::string::npos)
-		{
-			draws.push_back(input.substr(1, delimiterPos));
-			input.erase(0, delimiterPos + 1);
-		}
-
-		// Get the last draw
-		if (!input.empty())
-		{
-			draws.push_back(input.substr(1, input.size()));
-			input.clear();
-		}
-
-		// Keep track of the highest number of each color
-		int redMax, greenMax, blueMax;
-		for (const auto draw : draws)
-		{
-			int number = 0;
-			std::string number_str = "";
-			for (int i = 0; i < draw.size(); i++)
-			{
-				char c = draw[i];
-				if (!std::isdigit(c))
-				{
-					if (!number_str.empty())
-					{
-						number = std::atoi(number_str.c_str());
-						number_str.clear();
-					}
-				}
-
-				if (c == 'r')
-				{
-					redMax = std::max(redMax, number);
-					number = 0;
-					i += 3;
-				}
-				else if (c == 'g')
-				{
-					greenMax = std::max(greenMax, number);
-					number = 0;
-					i += 5;
-				}
-				else if (c == 'b')
-				{
-					blueMax = std::max(blueMax, number);
-					number = 0;
-					i += 4;
-				}
-				else if (std::isdigit(c))
-				{
-					number_str += c;
-				}
-			}
-		}
-
-		// Return the output
-		*redCubes = redMax;
-		*greenCubes = greenMax;
-		*blueCubes = blueMax;
-	}
-
-	int GetID() const { return id; }
-
-private:
-
-	int id;
-};
+// Since the cubes are put back after each draw, then all we care about is if the picked number of cubes of a certain color is greater
+// than the ones stated in the question (this would make the game impossible)
+static constexpr CubeCounts DRAW_LIMITS = { 12, 13, 14 };
 
 struct Day2_1 : public Challenge
 {
 	int Run(Input input)
 	{
 		// Question: which games would have been possible if the bag contained only 12 red cubes, 13 green cubes, and 14 blue cubes
-		int IDSum = 0;
-		for (auto line : input)
+		// Only the per-game maxima matter, so they're collected into columns and checked against the limits all at once
+		GameMaximaStore store;
+		store.Reserve(input.size());
+		for (const auto& line : input)
 		{
-			Game game;
-			bool possible = game.IsPossible(line);
-			if (possible)
-			{
-				std::cout << game.GetID() << " - [PASS] - " << line << std::endl;
-				IDSum += game.GetID();
-			}
-			else
-			{
-				std::cout << game.GetID() << " - [FAIL] - " << line << std::endl;
-			}
+			store.AddRecord(line);
 		}
 
+		int IDSum = static_cast<int>(store.SumPossibleIDs(DRAW_LIMITS));
+		Diag() << store.GetGameCount() << " games, possible ID sum " << IDSum << '\n';
+
 		return IDSum;
 	}
 };
@@ -261,21 +81,16 @@ struct Day2_2 : public Challenge
 	int Run(Input input)
 	{
 		// Question: what is the fewest number of cubes of each color that could have been in the bag to make the game possible?
-		int red, green, blue;
-		int powerSum = 0;
-
-		Game game;
-		for (const auto line : input)
+		GameMaximaStore store;
+		store.Reserve(input.size());
+		for (const auto& line : input)
 		{
-			int power = 0;
-			game.MinCubesRequiredToPlay(line, &red, &green, &blue);
-
-			std::cout << red << "R " << green << "G " << blue << "B - " << line << std::endl;
-
-			power = red * green * blue;
-			powerSum += power;
+			store.AddRecord(line);
 		}
 
+		int powerSum = static_cast<int>(store.SumPowers());
+		Diag() << store.GetGameCount() << " games, power sum " << powerSum << '\n';
+
 		return powerSum;
 	}
 };
\ No newline at end of file
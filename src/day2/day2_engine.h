@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../challenge.h"
+#include "../thread_pool.h"
+#include "game_store.h"
+
+struct Day2Sums
+{
+	uint64_t possibleIDs = 0;
+	uint64_t powers = 0;
+};
+
+// Both Day 2 questions over a large input on the thread pool. The lines are cut into fixed blocks; each task parses its
+// block into a store of its own and runs the kernels on it, so tasks share nothing while they work and only write
+// their own slot of the per-block results. The blocks are then added up in order on the calling thread, which makes
+// the result the same for any thread count.
+//
+// This waits on the pool, so it must not be called from inside a pool task (like a batch item in the runner)
+class Day2Engine
+{
+public:
+
+	static constexpr size_t DEFAULT_BLOCK_LINES = 4096;
+
+	static Day2Sums Evaluate(const Challenge::Input& input, const CubeCounts& limits, ThreadPool& pool, size_t blockLines = DEFAULT_BLOCK_LINES)
+	{
+		blockLines = std::max<size_t>(blockLines, 1);
+		size_t blockCount = (input.size() + blockLines - 1) / blockLines;
+
+		// One cache line per block, so neighbouring tasks never write to the same line
+		struct alignas(64) BlockSums
+		{
+			Day2Sums sums;
+		};
+		std::vector<BlockSums> blockSums(blockCount);
+
+		pool.ParallelFor(blockCount, [&](size_t block)
+		{
+			size_t begin = block * blockLines;
+			size_t end = std::min(input.size(), begin + blockLines);
+
+			GameMaximaStore store;
+			store.Reserve(end - begin);
+			for (size_t line = begin; line < end; line++)
+			{
+				store.AddRecord(input[line]);
+			}
+
+			blockSums[block].sums.possibleIDs = store.SumPossibleIDs(limits);
+			blockSums[block].sums.powers = store.SumPowers();
+		}, "Day2 block");
+
+		Day2Sums sums;
+		for (const auto& block : blockSums)
+		{
+			sums.possibleIDs += block.sums.possibleIDs;
+			sums.powers += block.sums.powers;
+		}
+
+		return sums;
+	}
+};
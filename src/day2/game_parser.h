@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+struct CubeCounts
+{
+	uint32_t red = 0;
+	uint32_t green = 0;
+	uint32_t blue = 0;
+};
+
+// Single pass parser for "Game <id>: <count> <color>, <count> <color>; ..." records. The line is read once, left to
+// right, by a small state machine; nothing is copied and nothing is allocated. Every draw (the groups separated by ';')
+// is handed to onDraw(const CubeCounts&) as soon as it's complete, so the caller decides where the counts end up.
+//
+// Returns false for anything that isn't a game record, which includes the empty line at the end of the input. Draws
+// before the point where a malformed line goes wrong will already have been handed out
+template<typename DrawHandler>
+bool ParseGameRecord(std::string_view line, uint32_t& out_id, DrawHandler&& onDraw)
+{
+	static constexpr std::string_view PREFIX = "Game ";
+	if (line.substr(0, PREFIX.size()) != PREFIX)
+	{
+		return false;
+	}
+
+	enum class State
+	{
+		ID,
+		BEFORE_COUNT,
+		COUNT,
+		BEFORE_COLOR,
+		COLOR,
+		AFTER_COLOR,
+	};
+
+	State state = State::ID;
+	uint32_t id = 0;
+	uint32_t count = 0;
+	uint32_t* target = nullptr;
+	CubeCounts draw;
+	bool hasID = false;
+
+	for (size_t i = PREFIX.size(); i < line.size(); i++)
+	{
+		char c = line[i];
+		bool isDigit = static_cast<unsigned char>(c - '0') < 10;
+
+		switch (state)
+		{
+		case State::ID:
+			if (isDigit)
+			{
+				id = id * 10 + static_cast<uint32_t>(c - '0');
+				hasID = true;
+			}
+			else if (c == ':' && hasID)
+			{
+				state = State::BEFORE_COUNT;
+			}
+			else
+			{
+				return false;
+			}
+			break;
+
+		case State::BEFORE_COUNT:
+			if (isDigit)
+			{
+				count = static_cast<uint32_t>(c - '0');
+				state = State::COUNT;
+			}
+			else if (c != ' ')
+			{
+				return false;
+			}
+			break;
+
+		case State::COUNT:
+			if (isDigit)
+			{
+				count = count * 10 + static_cast<uint32_t>(c - '0');
+			}
+			else if (c == ' ')
+			{
+				state = State::BEFORE_COLOR;
+			}
+			else
+			{
+				return false;
+			}
+			break;
+
+		case State::BEFORE_COLOR:
+			// The first letter is enough to tell the colors apart, the rest of the name is skipped in COLOR
+			if (c == 'r') target = &draw.red;
+			else if (c == 'g') target = &draw.green;
+			else if (c == 'b') target = &draw.blue;
+			else if (c == ' ') break;
+			else return false;
+
+			*target = count;
+			state = State::COLOR;
+			break;
+
+		case State::COLOR:
+		case State::AFTER_COLOR:
+			if (c == ',')
+			{
+				state = State::BEFORE_COUNT;
+			}
+			else if (c == ';')
+			{
+				onDraw(static_cast<const CubeCounts&>(draw));
+				draw = CubeCounts();
+				state = State::BEFORE_COUNT;
+			}
+			else if (c == ' ' || c == '\r')
+			{
+				state = State::AFTER_COLOR;
+			}
+			else if (state == State::AFTER_COLOR || c < 'a' || c > 'z')
+			{
+				return false;
+			}
+			break;
+		}
+	}
+
+	// The last draw has no ';' after it
+	if (state != State::COLOR && state != State::AFTER_COLOR)
+	{
+		return false;
+	}
+
+	onDraw(static_cast<const CubeCounts&>(draw));
+	out_id = id;
+	return true;
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_GAME_STORE_SSE2 1
+#endif
+
+#include "game_parser.h"
+
+// Minimal allocator that gives every column the alignment of a cache line
+template<typename T, size_t Alignment = 64>
+struct AlignedAllocator
+{
+	typedef T value_type;
+
+	template<typename U>
+	struct rebind
+	{
+		typedef AlignedAllocator<U, Alignment> other;
+	};
+
+	AlignedAllocator() = default;
+
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) { }
+
+	T* allocate(size_t count)
+	{
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+	}
+
+	void deallocate(T* pointer, size_t)
+	{
+		::operator delete(pointer, std::align_val_t(Alignment));
+	}
+
+	template<typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+	template<typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Day 2 only ever needs the highest count of each color per game, so after parsing that's all that's kept: one column
+// of ids and one column of maxima per color (structure of arrays). Both questions then become a single vectorized
+// pass over the columns. Maxima are kept at their full 32 bits, so counts and limits compare exactly up to UINT32_MAX;
+// sums are 64 bits (the power sum wraps around past that)
+class GameMaximaStore
+{
+public:
+
+	// Parses a game record and appends its maxima. Lines that aren't game records are skipped
+	bool AddRecord(std::string_view line)
+	{
+		uint32_t id = 0;
+		CubeCounts maxima;
+		bool parsed = ParseGameRecord(line, id, [&maxima](const CubeCounts& draw)
+		{
+			maxima.red = std::max(maxima.red, draw.red);
+			maxima.green = std::max(maxima.green, draw.green);
+			maxima.blue = std::max(maxima.blue, draw.blue);
+		});
+
+		if (parsed)
+		{
+			Add(id, maxima);
+		}
+
+		return parsed;
+	}
+
+	void Add(uint32_t id, const CubeCounts& maxima)
+	{
+		ids.push_back(id);
+		red.push_back(maxima.red);
+		green.push_back(maxima.green);
+		blue.push_back(maxima.blue);
+	}
+
+	void Reserve(size_t count)
+	{
+		ids.reserve(count);
+		red.reserve(count);
+		green.reserve(count);
+		blue.reserve(count);
+	}
+
+	size_t GetGameCount() const { return ids.size(); }
+	uint32_t GetID(size_t game) const { return ids[game]; }
+	CubeCounts GetMaxima(size_t game) const { return { red[game], green[game], blue[game] }; }
+
+	// Part 1: sum of the ids of the games in [begin, end) that never show more cubes of a color than the limit
+	uint64_t SumPossibleIDs(const CubeCounts& limits, size_t begin = 0, size_t end = SIZE_MAX) const
+	{
+		end = std::min(end, ids.size());
+		begin = std::min(begin, end);
+
+		uint64_t sum = 0;
+		size_t game = begin;
+
+#if defined(__AVX2__)
+		const __m256i redLimits = _mm256_set1_epi32(static_cast<int>(limits.red));
+		const __m256i greenLimits = _mm256_set1_epi32(static_cast<int>(limits.green));
+		const __m256i blueLimits = _mm256_set1_epi32(static_cast<int>(limits.blue));
+		__m256i sums = _mm256_setzero_si256();
+		for (; game + 8 <= end; game += 8)
+		{
+			// count <= limit exactly when max(count, limit) == limit, which is an unsigned compare
+			__m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&red[game]));
+			__m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&green[game]));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&blue[game]));
+			__m256i possible = _mm256_and_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(r, redLimits), redLimits),
+				_mm256_and_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(g, greenLimits), greenLimits), _mm256_cmpeq_epi32(_mm256_max_epu32(b, blueLimits), blueLimits)));
+
+			__m256i gameIDs = _mm256_and_si256(possible, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ids[game])));
+			sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(gameIDs)));
+			sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(gameIDs, 1)));
+		}
+		sum += HorizontalSum(sums);
+#elif AOC_GAME_STORE_SSE2
+		// SSE2 only has signed compares, flipping the sign bit of both sides makes them unsigned
+		const __m128i signBit = _mm_set1_epi32(INT32_MIN);
+		const __m128i redLimits = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(limits.red)), signBit);
+		const __m128i greenLimits = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(limits.green)), signBit);
+		const __m128i blueLimits = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(limits.blue)), signBit);
+		const __m128i zero = _mm_setzero_si128();
+		__m128i sums = _mm_setzero_si128();
+		for (; game + 4 <= end; game += 4)
+		{
+			__m128i r = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&red[game])), signBit);
+			__m128i g = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&green[game])), signBit);
+			__m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&blue[game])), signBit);
+			__m128i impossible = _mm_or_si128(_mm_cmpgt_epi32(r, redLimits), _mm_or_si128(_mm_cmpgt_epi32(g, greenLimits), _mm_cmpgt_epi32(b, blueLimits)));
+
+			__m128i gameIDs = _mm_andnot_si128(impossible, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ids[game])));
+			sums = _mm_add_epi64(sums, _mm_add_epi64(_mm_unpacklo_epi32(gameIDs, zero), _mm_unpackhi_epi32(gameIDs, zero)));
+		}
+		sum += HorizontalSum(sums);
+#endif
+
+		for (; game < end; game++)
+		{
+			if (red[game] <= limits.red && green[game] <= limits.green && blue[game] <= limits.blue)
+			{
+				sum += ids[game];
+			}
+		}
+
+		return sum;
+	}
+
+	// Part 2: sum of red * green * blue maxima over the games in [begin, end), modulo 2^64
+	uint64_t SumPowers(size_t begin = 0, size_t end = SIZE_MAX) const
+	{
+		end = std::min(end, ids.size());
+		begin = std::min(begin, end);
+
+		uint64_t sum = 0;
+		size_t game = begin;
+
+#if defined(__AVX2__)
+		__m256i sums = _mm256_setzero_si256();
+		for (; game + 8 <= end; game += 8)
+		{
+			__m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&red[game]));
+			__m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&green[game]));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&blue[game]));
+
+			// Even lanes, then odd lanes shifted down
+			sums = _mm256_add_epi64(sums, MultiplyLanes(r, g, b));
+			sums = _mm256_add_epi64(sums, MultiplyLanes(_mm256_srli_epi64(r, 32), _mm256_srli_epi64(g, 32), _mm256_srli_epi64(b, 32)));
+		}
+		sum += HorizontalSum(sums);
+#elif AOC_GAME_STORE_SSE2
+		__m128i sums = _mm_setzero_si128();
+		for (; game + 4 <= end; game += 4)
+		{
+			__m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&red[game]));
+			__m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&green[game]));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blue[game]));
+
+			sums = _mm_add_epi64(sums, MultiplyLanes(r, g, b));
+			sums = _mm_add_epi64(sums, MultiplyLanes(_mm_srli_epi64(r, 32), _mm_srli_epi64(g, 32), _mm_srli_epi64(b, 32)));
+		}
+		sum += HorizontalSum(sums);
+#endif
+
+		for (; game < end; game++)
+		{
+			sum += static_cast<uint64_t>(red[game]) * green[game] * blue[game];
+		}
+
+		return sum;
+	}
+
+private:
+
+	// r * g * b modulo 2^64 for the low 32 bits of every 64-bit lane. r * g is exact in 64 bits, and of its product with
+	// b only the low half of (high word * b) still lands in the low 64 bits
+#if defined(__AVX2__)
+	static __m256i MultiplyLanes(__m256i r, __m256i g, __m256i b)
+	{
+		__m256i rg = _mm256_mul_epu32(r, g);
+		__m256i high = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(rg, 32), b), 32);
+		return _mm256_add_epi64(_mm256_mul_epu32(rg, b), high);
+	}
+
+	static uint64_t HorizontalSum(__m256i values)
+	{
+		alignas(32) uint64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), values);
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+#elif AOC_GAME_STORE_SSE2
+	static __m128i MultiplyLanes(__m128i r, __m128i g, __m128i b)
+	{
+		__m128i rg = _mm_mul_epu32(r, g);
+		__m128i high = _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(rg, 32), b), 32);
+		return _mm_add_epi64(_mm_mul_epu32(rg, b), high);
+	}
+
+	static uint64_t HorizontalSum(__m128i values)
+	{
+		alignas(16) uint64_t lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), values);
+		return lanes[0] + lanes[1];
+	}
+#endif
+
+	std::vector<uint32_t, AlignedAllocator<uint32_t>> ids;
+	std::vector<uint32_t, AlignedAllocator<uint32_t>> red;
+	std::vector<uint32_t, AlignedAllocator<uint32_t>> green;
+	std::vector<uint32_t, AlignedAllocator<uint32_t>> blue;
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../challenge.h"
+#include "schematic_index.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Part 1 as bit operations. "Is this digit touching a symbol" is the 3x3 dilation of the symbol mask, intersected with
+// the digit mask. With one bit per cell, the dilation of a row is the OR of the symbol rows above, at and below it,
+// spread one column left and right by shifting the words, so every instruction handles 64 cells. A digit run is a part
+// number if its mask has any bit in common with the result.
+//
+// The input is only referenced, not copied, so it has to outlive the object
+class BitplaneSchematic
+{
+public:
+
+	BitplaneSchematic(const Challenge::Input& _input) : input(_input)
+	{
+		height = input.size();
+		size_t width = 0;
+		for (const auto& line : input)
+		{
+			width = std::max(width, line.size());
+		}
+
+		// Always at least one bit past the end of the longest row, so a digit run ends inside its row's words
+		wordsPerRow = width / 64 + 1;
+		symbols.assign(wordsPerRow * height, 0);
+		digits.assign(wordsPerRow * height, 0);
+
+		for (size_t y = 0; y < height; y++)
+		{
+			const std::string& line = input[y];
+			uint64_t* symbolRow = &symbols[y * wordsPerRow];
+			uint64_t* digitRow = &digits[y * wordsPerRow];
+			for (size_t x = 0; x < line.size(); x++)
+			{
+				uint64_t bit = uint64_t(1) << (x % 64);
+				if (IsSchematicDigit(line[x])) digitRow[x / 64] |= bit;
+				else if (IsSchematicSymbol(line[x])) symbolRow[x / 64] |= bit;
+			}
+		}
+	}
+
+	uint64_t SumPartNumbers() const
+	{
+		uint64_t sum = 0;
+
+		std::vector<uint64_t> vertical(wordsPerRow);
+		std::vector<uint64_t> touched(wordsPerRow);
+		for (size_t y = 0; y < height; y++)
+		{
+			const uint64_t* above = y > 0 ? &symbols[(y - 1) * wordsPerRow] : nullptr;
+			const uint64_t* center = &symbols[y * wordsPerRow];
+			const uint64_t* below = y + 1 < height ? &symbols[(y + 1) * wordsPerRow] : nullptr;
+			const uint64_t* digitRow = &digits[y * wordsPerRow];
+
+			bool anyDigits = false;
+			for (size_t w = 0; w < wordsPerRow; w++)
+			{
+				vertical[w] = center[w] | (above ? above[w] : 0) | (below ? below[w] : 0);
+				anyDigits |= digitRow[w] != 0;
+			}
+
+			if (!anyDigits)
+			{
+				continue;
+			}
+
+			// Horizontal spread, carrying the bits that cross a word boundary in from the neighboring words
+			for (size_t w = 0; w < wordsPerRow; w++)
+			{
+				uint64_t left = (vertical[w] << 1) | (w > 0 ? vertical[w - 1] >> 63 : 0);
+				uint64_t right = (vertical[w] >> 1) | (w + 1 < wordsPerRow ? vertical[w + 1] << 63 : 0);
+				touched[w] = (vertical[w] | left | right) & digitRow[w];
+			}
+
+			sum += SumTouchedRuns(input[y], digitRow, touched.data());
+		}
+
+		return sum;
+	}
+
+private:
+
+	static uint32_t CountTrailingZeros(uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return index;
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+	}
+
+	// Walks the digit runs of a row straight from the bit-plane, and adds up the ones with a touched bit
+	uint64_t SumTouchedRuns(const std::string& line, const uint64_t* digitRow, const uint64_t* touchedRow) const
+	{
+		uint64_t sum = 0;
+
+		size_t x = 0;
+		size_t rowBits = wordsPerRow * 64;
+		while (x < rowBits)
+		{
+			// Next digit at or after x
+			size_t w = x / 64;
+			uint64_t remaining = digitRow[w] & (~uint64_t(0) << (x % 64));
+			while (remaining == 0 && ++w < wordsPerRow)
+			{
+				remaining = digitRow[w];
+			}
+			if (remaining == 0)
+			{
+				break;
+			}
+			size_t begin = w * 64 + CountTrailingZeros(remaining);
+
+			// First non-digit after it
+			w = begin / 64;
+			uint64_t gaps = ~digitRow[w] & (~uint64_t(0) << (begin % 64));
+			while (gaps == 0)
+			{
+				gaps = ~digitRow[++w];
+			}
+			size_t end = w * 64 + CountTrailingZeros(gaps);
+
+			if (AnyBitInRange(touchedRow, begin, end))
+			{
+				uint64_t value = 0;
+				for (size_t i = begin; i < end; i++)
+				{
+					value = value * 10 + static_cast<uint64_t>(line[i] - '0');
+				}
+				sum += value;
+			}
+
+			x = end;
+		}
+
+		return sum;
+	}
+
+	static bool AnyBitInRange(const uint64_t* row, size_t begin, size_t end)
+	{
+		for (size_t w = begin / 64; w * 64 < end; w++)
+		{
+			uint64_t mask = ~uint64_t(0);
+			if (w == begin / 64) mask &= ~uint64_t(0) << (begin % 64);
+			if (w == (end - 1) / 64) mask &= ~uint64_t(0) >> (63 - (end - 1) % 64);
+			if (row[w] & mask) return true;
+		}
+		return false;
+	}
+
+	const Challenge::Input& input;
+	size_t height;
+	size_t wordsPerRow;
+
+	// One bit per cell, row-major, wordsPerRow words per row
+	std::vector<uint64_t> symbols;
+	std::vector<uint64_t> digits;
+};
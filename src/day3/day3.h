@@ -27,134 +27,18 @@
 // 
 // Of course, the actual engine schematic is much larger.What is the sum of all of the part numbers in the engine schematic ?
 
-#include <algorithm>
-#include <assert.h>
-#include <unordered_map>
-#include <vector>
-
 #include "../challenge.h"
+#include "bitplane_schematic.h"
+#include "schematic_index.h"
+#include "symbol_adjacency.h"
 
 struct Day3_1 : public Challenge
 {
-	bool IsSymbol(char c)
-	{
-		return !std::isdigit(c) && (c != '.');
-	}
-
-	// Clamps x and y to remain inbounds (no wrapping), and returns the character at the index
-	char SafeAt(int x, int y, Input input)
-	{
-		int lineSize = input[0].size();
-		x = std::clamp(x, 0, lineSize);
-		y = std::clamp(y, 0, (int)input.size());
-		return input[y][x];
-	}
-
 	int Run(Input input)
 	{
-		typedef std::pair<int, int> Index;
-
-		static const Index SEARCH_KERNEL[9] =
-		{
-			{ -1, -1 }, { 0, -1 }, { 1, -1 },
-			{ -1, 0 }, { 0, 0 }, { 1, 0 },
-			{ -1, 1 }, { 0, 1 }, { 1, 1 }
-		};
-
-		std::vector<Index> partNumberIndex;
-		for (int y = 0; y < input.size(); y++)
-		{
-			std::string line = input[y];
-			for (int x = 0; x < line.size(); x++)
-			{
-				char c = input[y][x];
-				if (IsSymbol(c))
-				{
-					for (auto offset : SEARCH_KERNEL)
-					{
-						Index currentOffset{ x + offset.first, y + offset.second };
-						char newC = SafeAt(currentOffset.first, currentOffset.second, input);
-						if (std::isdigit(newC))
-						{
-							partNumberIndex.push_back(currentOffset);
-						}
-					}
-				}
-			}
-		}
-
-		// Look for the entire numbers
-		std::unordered_map<int, std::vector<Index>> partNumbers;
-		for (auto index : partNumberIndex)
-		{
-			std::string numberStr = "";
-
-			// Back-track to first digit
-			Index currIndex = index;
-			while (currIndex.first >= 0 && std::isdigit(input[currIndex.second][currIndex.first]))
-			{
-				currIndex.first -= 1;
-			}
-
-			currIndex.first += 1; // Go forward one to valid index
-			// Run forward to get all digits
-			while (currIndex.first < input[0].size() && std::isdigit(input[currIndex.second][currIndex.first]))
-			{
-				numberStr += input[currIndex.second][currIndex.first];
-				currIndex.first += 1;
-			}
-
-			int newNumber = std::atoi(numberStr.c_str());
-			auto numberIter = partNumbers.find(newNumber);
-			if (numberIter != partNumbers.end())
-			{
-				// Duplicate?
-				// Find distance between this number and all other instances. If it's less than 3 then it's the same number, since
-				// that's all the kernel traversed
-				bool isDifferentNumber = true;
-				auto& numberIndexList = numberIter->second;
-				for (const auto& indexInstance : numberIndexList)
-				{
-					// Only consider horizontal distance if we're talking about the same row, otherwise it's definitely a different number
-					if (indexInstance.second != index.second)
-					{
-						continue;
-					}
-					else
-					{
-						int horDistance = std::abs(indexInstance.first - index.first);
-						if (horDistance < 3)
-						{
-							isDifferentNumber = false;
-							break;
-						}
-					}
-				}
-
-				if (isDifferentNumber)
-				{
-					numberIndexList.push_back(index);
-				}
-			}
-			else
-			{
-				// First time finding this number, add it to the list
-				partNumbers.insert({ newNumber, { index } });
-			}
-
-			//if (partNumbers.find(newNumber) != partNumbers.end())
-			//{
-			//	std::cout << "Duplicate: " << newNumber << std::endl;
-			//}
-		}
-
-		int sum = 0;
-		for (const auto& iter : partNumbers)
-		{
-			sum += iter.first * iter.second.size();
-		}
-
-		return sum;
+		// Part 1 doesn't need to know which symbol a number touches, so the bit-plane path is enough
+		BitplaneSchematic planes(input);
+		return static_cast<int>(planes.SumPartNumbers());
 	}
 };
 
@@ -187,109 +71,11 @@ struct Day3_1 : public Challenge
 
 struct Day3_2 : public Challenge
 {
-	// Clamps x and y to remain inbounds (no wrapping), and returns the character at the index
-	char SafeAt(int x, int y, Input input)
-	{
-		int lineSize = input[0].size();
-		x = std::clamp(x, 0, lineSize);
-		y = std::clamp(y, 0, (int)input.size());
-		return input[y][x];
-	}
-
-	// A gear is any '*' character with exactly two neighboring part numbers. This function
-	// calculates if the given character 'c' is a gear and returns the gear ratio in that case
-	// Otherwise, it returns 0
-	int CalculateGearRatio(int x, int y, Input input)
-	{
-		typedef std::pair<int, int> Index;
-
-		static const Index SEARCH_KERNEL[9] =
-		{
-			{ -1, -1 }, { 0, -1 }, { 1, -1 },
-			{ -1, 0 }, { 0, 0 }, { 1, 0 },
-			{ -1, 1 }, { 0, 1 }, { 1, 1 }
-		};
-
-		char c = SafeAt(x, y, input);
-		if (c == '*')
-		{
-			std::vector<Index> neighbors;
-
-			for (const auto& offset : SEARCH_KERNEL)
-			{
-				Index newIndex = { x + offset.first, y + offset.second };
-				char newC = SafeAt(x + offset.first, y + offset.second, input);
-				if (std::isdigit(newC))
-				{
-					neighbors.push_back(newIndex);
-				}
-			}
-
-			// Collapse contiguous neighbors
-			auto neighborsSafe = neighbors;
-			Index prevNeighbor = { -1, -1 };
-			int neighborsRemoved = 0;
-			for (int i = 0; i < neighborsSafe.size(); i++)
-			{
-				Index neighbor = neighborsSafe[i];
-				if (neighbor.second == prevNeighbor.second)
-				{
-					// The current neighbor is right next to the previous neighbor horizontally (let's remove the previous neighbor)
-					if (neighbor.first - 1 == prevNeighbor.first)
-					{
-						neighbors.erase(neighbors.begin() + (i - neighborsRemoved));
-						neighborsRemoved++;
-					}
-				}
-
-				prevNeighbor = neighbor;
-			}
-
-			// Get the actual numbers. These don't matter unless we have exactly two
-			std::vector<int> gearNumbers;
-			if (neighbors.size() == 2)
-			{
-				for (const auto& index : neighbors)
-				{
-					Index currIndex = index;
-					std::string numberStr = "";
-					while (currIndex.first >= 0 && std::isdigit(input[currIndex.second][currIndex.first]))
-					{
-						currIndex.first -= 1;
-					}
-
-					currIndex.first += 1; // Go forward one to valid index
-					// Run forward to get all digits
-					while (currIndex.first < input[0].size() && std::isdigit(input[currIndex.second][currIndex.first]))
-					{
-						numberStr += input[currIndex.second][currIndex.first];
-						currIndex.first += 1;
-					}
-
-					gearNumbers.push_back(std::atoi(numberStr.c_str()));
-				}
-
-				assert(gearNumbers.size() == 2);
-
-				return gearNumbers[0] * gearNumbers[1];
-			}
-		}
-
-		return 0;
-	}
-
 	int Run(Input input)
 	{
-		int sum = 0;
-		for (int y = 0; y < input.size(); y++)
-		{
-			auto line = input[y];
-			for (int x = 0; x < line.size(); x++)
-			{
-				sum += CalculateGearRatio(x, y, input);
-			}
-		}
-
-		return sum;
+		// A gear is any '*' character with exactly two neighboring part numbers
+		SchematicIndex index(input);
+		SymbolAdjacency adjacency(index);
+		return static_cast<int>(adjacency.SumGearRatios('*', 2));
 	}
-};
\ No newline at end of file
+};
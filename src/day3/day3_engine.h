@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../challenge.h"
+#include "../thread_pool.h"
+#include "row_runs.h"
+
+struct Day3Sums
+{
+	uint64_t partNumbers = 0;
+	uint64_t gearRatios = 0;
+};
+
+// Both Day 3 questions for very tall schematics, split into horizontal bands on the thread pool. Each band also scans
+// one halo row above and below it, which is all it needs to decide adjacency for its own rows, so bands never wait on
+// each other. A number or gear is only ever counted by the band that owns its row, so anything touching a band edge is
+// still counted exactly once. Per-band sums are added up in band order at the end.
+//
+// This waits on the pool, so it must not be called from inside a pool task (like a batch item in the runner)
+class Day3Engine
+{
+public:
+
+	static constexpr size_t DEFAULT_BAND_ROWS = 1024;
+
+	static Day3Sums Evaluate(const Challenge::Input& input, ThreadPool& pool, size_t bandRows = DEFAULT_BAND_ROWS)
+	{
+		bandRows = std::max<size_t>(bandRows, 1);
+		size_t bandCount = (input.size() + bandRows - 1) / bandRows;
+
+		struct alignas(64) BandSums
+		{
+			Day3Sums sums;
+		};
+		std::vector<BandSums> bandSums(bandCount);
+
+		pool.ParallelFor(bandCount, [&](size_t band)
+		{
+			size_t begin = band * bandRows;
+			size_t end = std::min(input.size(), begin + bandRows);
+			bandSums[band].sums = EvaluateBand(input, begin, end);
+		}, "Day3 band");
+
+		Day3Sums sums;
+		for (const auto& band : bandSums)
+		{
+			sums.partNumbers += band.sums.partNumbers;
+			sums.gearRatios += band.sums.gearRatios;
+		}
+
+		return sums;
+	}
+
+	// Rows [begin, end), reading the halo rows begin - 1 and end when they exist
+	static Day3Sums EvaluateBand(const Challenge::Input& input, size_t begin, size_t end)
+	{
+		Day3Sums sums;
+		if (begin >= end)
+		{
+			return sums;
+		}
+
+		// Sliding window of three scanned rows: above, current and below
+		SchematicRow window[3];
+		bool hasAbove = begin > 0;
+		if (hasAbove)
+		{
+			ScanSchematicRow(input[begin - 1], static_cast<uint32_t>(begin - 1), window[0]);
+		}
+		ScanSchematicRow(input[begin], static_cast<uint32_t>(begin), window[1]);
+
+		for (size_t y = begin; y < end; y++)
+		{
+			bool hasBelow = y + 1 < input.size();
+			if (hasBelow)
+			{
+				ScanSchematicRow(input[y + 1], static_cast<uint32_t>(y + 1), window[2]);
+			}
+			else
+			{
+				window[2].Clear();
+			}
+
+			const SchematicRow* above = hasAbove ? &window[0] : nullptr;
+			const SchematicRow* below = hasBelow ? &window[2] : nullptr;
+			sums.partNumbers += SumRowPartNumbers(window[1], above, below);
+			sums.gearRatios += SumRowGearRatios(window[1], above, below);
+
+			// Shift the window down, swapping keeps the row vectors' capacity around
+			std::swap(window[0], window[1]);
+			std::swap(window[1], window[2]);
+			hasAbove = true;
+		}
+
+		return sums;
+	}
+};
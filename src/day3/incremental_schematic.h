@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../challenge.h"
+#include "schematic_index.h"
+
+struct CellEdit
+{
+	uint32_t x;
+	uint32_t y;
+	char value;
+};
+
+// Day 3 model for a schematic that keeps being edited a few cells at a time. It keeps the span labels of
+// SchematicIndex, plus for every span the number of symbol cells around it, and the ratio every gear currently
+// contributes. An edit batch only touches the spans that contain or border an edited cell, the spans around edited
+// symbol cells, and the '*' cells within one cell of any span that changed, so both sums stay current without ever
+// rescanning the grid.
+//
+// The grid keeps the size it was created with (the longest row, padded with '.'); edits outside of it are ignored
+class IncrementalSchematic
+{
+public:
+
+	static constexpr uint32_t NO_SPAN = UINT32_MAX;
+
+	IncrementalSchematic(const Challenge::Input& input)
+	{
+		height = static_cast<uint32_t>(input.size());
+		width = 0;
+		for (const auto& line : input)
+		{
+			width = std::max(width, static_cast<uint32_t>(line.size()));
+		}
+
+		cells.assign(static_cast<size_t>(width) * height, '.');
+		labels.assign(cells.size(), NO_SPAN);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			std::copy(input[y].begin(), input[y].end(), cells.begin() + Cell(0, y));
+		}
+
+		std::vector<size_t> gearCandidates;
+		for (uint32_t y = 0; y < height; y++)
+		{
+			uint32_t x = 0;
+			while (x < width)
+			{
+				if (IsSchematicDigit(cells[Cell(x, y)]))
+				{
+					x = spans[AddSpan(x, y, gearCandidates)].end;
+					gearCandidates.clear();
+				}
+				else
+				{
+					x++;
+				}
+			}
+		}
+
+		for (size_t cell = 0; cell < cells.size(); cell++)
+		{
+			if (cells[cell] == '*') UpdateGear(cell);
+		}
+	}
+
+	uint32_t GetWidth() const { return width; }
+	uint32_t GetHeight() const { return height; }
+	char GetCell(uint32_t x, uint32_t y) const { return cells[Cell(x, y)]; }
+
+	uint64_t GetPartNumberSum() const { return partNumberSum; }
+	uint64_t GetGearRatioSum() const { return gearRatioSum; }
+
+	// Applies a batch of edits, in order. Returns false if any of them was outside the grid (those are skipped)
+	bool ApplyEdits(const std::vector<CellEdit>& edits)
+	{
+		bool allInside = true;
+
+		// Rows and column ranges that have to be tokenized again, and '*' cells whose neighborhood may have changed
+		std::vector<NumberSpan> dirtyRanges;
+		std::vector<size_t> gearCandidates;
+
+		// Every span that contains or borders an edited cell can change its digits or merge with another one, so they
+		// all go first. Their labels are cleared, which keeps the symbol updates below from counting them
+		for (const auto& edit : edits)
+		{
+			if (edit.x >= width || edit.y >= height)
+			{
+				allInside = false;
+				continue;
+			}
+
+			dirtyRanges.push_back({ 0, edit.y, edit.x, edit.x + 1 });
+			for (int64_t dx = -1; dx <= 1; dx++)
+			{
+				uint32_t span = GetLabel(static_cast<int64_t>(edit.x) + dx, edit.y);
+				if (span != NO_SPAN)
+				{
+					dirtyRanges.push_back(spans[span]);
+					RemoveSpan(span, gearCandidates);
+				}
+			}
+		}
+
+		// Symbols that appear or disappear change the symbol count of the (surviving) spans around them
+		for (const auto& edit : edits)
+		{
+			if (edit.x >= width || edit.y >= height) continue;
+
+			size_t cell = Cell(edit.x, edit.y);
+			bool wasSymbol = IsSchematicSymbol(cells[cell]);
+			bool isSymbol = IsSchematicSymbol(edit.value);
+			cells[cell] = edit.value;
+			gearCandidates.push_back(cell);
+
+			if (wasSymbol != isSymbol)
+			{
+				uint32_t adjacent[6];
+				uint32_t count = GetAdjacentSpans(edit.x, edit.y, adjacent);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					AdjustSymbolCount(adjacent[i], isSymbol ? 1 : -1);
+				}
+			}
+		}
+
+		// Digit runs in the dirty ranges (and right next to them, where a run may now continue) become spans again
+		for (const auto& range : dirtyRanges)
+		{
+			uint32_t begin = range.begin > 0 ? range.begin - 1 : 0;
+			uint32_t end = std::min(range.end + 1, width);
+			for (uint32_t x = begin; x < end; x++)
+			{
+				size_t cell = Cell(x, range.row);
+				if (IsSchematicDigit(cells[cell]) && labels[cell] == NO_SPAN)
+				{
+					// The run may have started left of the range, so go back to its first digit
+					uint32_t begin = x;
+					while (begin > 0 && IsSchematicDigit(cells[cell - (x - begin) - 1]))
+					{
+						begin--;
+					}
+					x = spans[AddSpan(begin, range.row, gearCandidates)].end - 1;
+				}
+			}
+		}
+
+		std::sort(gearCandidates.begin(), gearCandidates.end());
+		gearCandidates.erase(std::unique(gearCandidates.begin(), gearCandidates.end()), gearCandidates.end());
+		for (auto cell : gearCandidates)
+		{
+			UpdateGear(cell);
+		}
+
+		return allInside;
+	}
+
+private:
+
+	struct LiveSpan : public NumberSpan
+	{
+		uint32_t symbolCount;
+	};
+
+	size_t Cell(uint32_t x, uint32_t y) const
+	{
+		return static_cast<size_t>(y) * width + x;
+	}
+
+	uint32_t GetLabel(int64_t x, int64_t y) const
+	{
+		if (x < 0 || y < 0 || x >= width || y >= height)
+		{
+			return NO_SPAN;
+		}
+		return labels[Cell(static_cast<uint32_t>(x), static_cast<uint32_t>(y))];
+	}
+
+	// Same as SchematicIndex::GetAdjacentSpans
+	uint32_t GetAdjacentSpans(uint32_t x, uint32_t y, uint32_t out_spans[6]) const
+	{
+		uint32_t count = 0;
+		for (int64_t dy = -1; dy <= 1; dy++)
+		{
+			uint32_t previous = NO_SPAN;
+			for (int64_t dx = -1; dx <= 1; dx++)
+			{
+				uint32_t label = GetLabel(static_cast<int64_t>(x) + dx, static_cast<int64_t>(y) + dy);
+				if (label != NO_SPAN && label != previous)
+				{
+					out_spans[count++] = label;
+				}
+				previous = label;
+			}
+		}
+		return count;
+	}
+
+	// Every '*' in the block around a span, [begin - 1, end] on the rows above, at and below it
+	void CollectGearCandidates(const NumberSpan& span, std::vector<size_t>& out_candidates) const
+	{
+		uint32_t begin = span.begin > 0 ? span.begin - 1 : 0;
+		uint32_t end = std::min(span.end + 1, width);
+		uint32_t firstRow = span.row > 0 ? span.row - 1 : 0;
+		uint32_t lastRow = std::min(span.row + 1, height - 1);
+		for (uint32_t y = firstRow; y <= lastRow; y++)
+		{
+			for (uint32_t x = begin; x < end; x++)
+			{
+				if (cells[Cell(x, y)] == '*') out_candidates.push_back(Cell(x, y));
+			}
+		}
+	}
+
+	// Tokenizes the digit run starting at (x, y), labels it and counts the symbols around it
+	uint32_t AddSpan(uint32_t x, uint32_t y, std::vector<size_t>& out_gearCandidates)
+	{
+		uint32_t id;
+		if (!freeSpans.empty())
+		{
+			id = freeSpans.back();
+			freeSpans.pop_back();
+		}
+		else
+		{
+			id = static_cast<uint32_t>(spans.size());
+			spans.emplace_back();
+		}
+
+		LiveSpan span = {};
+		span.row = y;
+		span.begin = x;
+		span.end = x;
+		while (span.end < width && IsSchematicDigit(cells[Cell(span.end, y)]))
+		{
+			span.value = span.value * 10 + static_cast<uint32_t>(cells[Cell(span.end, y)] - '0');
+			labels[Cell(span.end, y)] = id;
+			span.end++;
+		}
+
+		uint32_t begin = span.begin > 0 ? span.begin - 1 : 0;
+		uint32_t end = std::min(span.end + 1, width);
+		uint32_t firstRow = y > 0 ? y - 1 : 0;
+		uint32_t lastRow = std::min(y + 1, height - 1);
+		for (uint32_t row = firstRow; row <= lastRow; row++)
+		{
+			for (uint32_t column = begin; column < end; column++)
+			{
+				if (IsSchematicSymbol(cells[Cell(column, row)])) span.symbolCount++;
+			}
+		}
+
+		spans[id] = span;
+		if (span.symbolCount > 0)
+		{
+			partNumberSum += span.value;
+		}
+
+		CollectGearCandidates(span, out_gearCandidates);
+		return id;
+	}
+
+	void RemoveSpan(uint32_t id, std::vector<size_t>& out_gearCandidates)
+	{
+		LiveSpan& span = spans[id];
+		if (span.symbolCount > 0)
+		{
+			partNumberSum -= span.value;
+		}
+
+		for (uint32_t x = span.begin; x < span.end; x++)
+		{
+			labels[Cell(x, span.row)] = NO_SPAN;
+		}
+
+		CollectGearCandidates(span, out_gearCandidates);
+		freeSpans.push_back(id);
+	}
+
+	void AdjustSymbolCount(uint32_t id, int delta)
+	{
+		LiveSpan& span = spans[id];
+		bool wasPart = span.symbolCount > 0;
+		span.symbolCount = static_cast<uint32_t>(static_cast<int64_t>(span.symbolCount) + delta);
+		bool isPart = span.symbolCount > 0;
+
+		if (wasPart && !isPart) partNumberSum -= span.value;
+		if (!wasPart && isPart) partNumberSum += span.value;
+	}
+
+	// Recomputes what the cell contributes as a gear, replacing whatever it contributed before
+	void UpdateGear(size_t cell)
+	{
+		uint64_t ratio = 0;
+		if (cells[cell] == '*')
+		{
+			uint32_t adjacent[6];
+			uint32_t x = static_cast<uint32_t>(cell % width);
+			uint32_t y = static_cast<uint32_t>(cell / width);
+			if (GetAdjacentSpans(x, y, adjacent) == 2)
+			{
+				ratio = static_cast<uint64_t>(spans[adjacent[0]].value) * spans[adjacent[1]].value;
+			}
+		}
+
+		auto iter = gearRatios.find(cell);
+		if (iter != gearRatios.end())
+		{
+			gearRatioSum -= iter->second;
+			if (ratio == 0)
+			{
+				gearRatios.erase(iter);
+			}
+			else
+			{
+				iter->second = ratio;
+			}
+		}
+		else if (ratio != 0)
+		{
+			gearRatios.emplace(cell, ratio);
+		}
+
+		gearRatioSum += ratio;
+	}
+
+	uint32_t width;
+	uint32_t height;
+
+	std::string cells;
+	std::vector<uint32_t> labels;
+
+	// Removed spans are recycled through the free list, so ids stay small however long the schematic is edited
+	std::vector<LiveSpan> spans;
+	std::vector<uint32_t> freeSpans;
+
+	// Only the gears that currently contribute something are in here
+	std::unordered_map<size_t, uint64_t> gearRatios;
+
+	uint64_t partNumberSum = 0;
+	uint64_t gearRatioSum = 0;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "schematic_index.h"
+
+// Day 3 one row at a time: a row is reduced to its digit runs and symbol cells (both sorted by column, which is how
+// they're found), and every adjacency question only needs the row itself plus the rows directly above and below it.
+// Matching the sorted lists of three rows against each other is a merge, so the work follows the number of runs
+// rather than the row width
+struct SchematicRow
+{
+	std::vector<NumberSpan> numbers;
+	std::vector<SymbolCell> symbols;
+
+	void Clear()
+	{
+		numbers.clear();
+		symbols.clear();
+	}
+};
+
+// Read-only window over runs stored somewhere else (like one row of a SparseSchematic's flat arrays)
+template<typename T>
+struct RunSlice
+{
+	const T* data = nullptr;
+	size_t count = 0;
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	const T& operator[](size_t i) const { return data[i]; }
+	const T* begin() const { return data; }
+	const T* end() const { return data + count; }
+};
+
+// Same shape as SchematicRow, so the merges below take either
+struct SchematicRowView
+{
+	RunSlice<NumberSpan> numbers;
+	RunSlice<SymbolCell> symbols;
+};
+
+inline void ScanSchematicRow(std::string_view line, uint32_t row, SchematicRow& out_row)
+{
+	out_row.Clear();
+
+	uint32_t x = 0;
+	uint32_t size = static_cast<uint32_t>(line.size());
+	while (x < size)
+	{
+		char c = line[x];
+		if (!IsSchematicDigit(c))
+		{
+			if (IsSchematicSymbol(c))
+			{
+				out_row.symbols.push_back({ row, x, c });
+			}
+			x++;
+			continue;
+		}
+
+		NumberSpan span = { 0, row, x, x };
+		while (span.end < size && IsSchematicDigit(line[span.end]))
+		{
+			span.value = span.value * 10 + static_cast<uint32_t>(line[span.end] - '0');
+			span.end++;
+		}
+
+		out_row.numbers.push_back(span);
+		x = span.end;
+	}
+}
+
+// Part 1 for the numbers of one row: a number counts if any of the three rows has a symbol in [begin - 1, end]. The
+// numbers are in column order, so each row's symbol cursor only ever moves forward
+template<typename Row>
+uint64_t SumRowPartNumbers(const Row& row, const Row* above, const Row* below)
+{
+	const Row* neighbors[3] = { above, &row, below };
+	size_t cursors[3] = { 0, 0, 0 };
+
+	uint64_t sum = 0;
+	for (const auto& number : row.numbers)
+	{
+		bool isPart = false;
+		for (int i = 0; i < 3; i++)
+		{
+			if (neighbors[i] == nullptr) continue;
+
+			const auto& symbols = neighbors[i]->symbols;
+			size_t& cursor = cursors[i];
+			while (cursor < symbols.size() && symbols[cursor].column + 1 < number.begin)
+			{
+				cursor++;
+			}
+
+			if (cursor < symbols.size() && symbols[cursor].column <= number.end)
+			{
+				isPart = true;
+			}
+		}
+
+		if (isPart)
+		{
+			sum += number.value;
+		}
+	}
+
+	return sum;
+}
+
+// Calls onNumber(const NumberSpan&) for every number in the three rows that touches the cell at column, and returns
+// how many there were. cursors has to start at 0 for each row, and columns have to be visited in increasing order
+template<typename Row, typename NumberHandler>
+uint32_t ForEachAdjacentNumber(uint32_t column, const Row* rows[3], size_t cursors[3], NumberHandler&& onNumber)
+{
+	uint32_t count = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		if (rows[i] == nullptr) continue;
+
+		const auto& numbers = rows[i]->numbers;
+		size_t& cursor = cursors[i];
+
+		// Numbers ending left of column - 1 can't touch this column or any later one
+		while (cursor < numbers.size() && numbers[cursor].end < column)
+		{
+			cursor++;
+		}
+
+		for (size_t n = cursor; n < numbers.size() && numbers[n].begin <= column + 1; n++)
+		{
+			onNumber(numbers[n]);
+			count++;
+		}
+	}
+	return count;
+}
+
+// Part 2 for the '*' cells of one row: a gear touches exactly two numbers across the three rows
+template<typename Row>
+uint64_t SumRowGearRatios(const Row& row, const Row* above, const Row* below)
+{
+	const Row* neighbors[3] = { above, &row, below };
+	size_t cursors[3] = { 0, 0, 0 };
+
+	uint64_t sum = 0;
+	for (const auto& symbol : row.symbols)
+	{
+		if (symbol.symbol != '*') continue;
+
+		uint64_t ratio = 1;
+		uint32_t count = ForEachAdjacentNumber(symbol.column, neighbors, cursors, [&ratio](const NumberSpan& number)
+		{
+			ratio *= number.value;
+		});
+
+		if (count == 2)
+		{
+			sum += ratio;
+		}
+	}
+
+	return sum;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../challenge.h"
+
+// A run of digits in the schematic, [begin, end) on its row
+struct NumberSpan
+{
+	uint32_t value;
+	uint32_t row;
+	uint32_t begin;
+	uint32_t end;
+};
+
+struct SymbolCell
+{
+	uint32_t row;
+	uint32_t column;
+	char symbol;
+};
+
+inline bool IsSchematicDigit(char c)
+{
+	return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Anything that isn't a digit, '.' or a stray line ending
+inline bool IsSchematicSymbol(char c)
+{
+	return c != '.' && c != '\r' && c != '\n' && !IsSchematicDigit(c);
+}
+
+// Labels every digit run of the schematic with a span id, in one pass over the cells. Adjacency questions then become
+// label lookups around the symbols, and the labels take care of telling apart equal numbers that sit close together.
+//
+// Rows can have different lengths (the input ends with an empty line); anything past the end of a row counts as '.'
+class SchematicIndex
+{
+public:
+
+	static constexpr uint32_t NO_SPAN = UINT32_MAX;
+
+	SchematicIndex(const Challenge::Input& input)
+	{
+		height = static_cast<uint32_t>(input.size());
+		width = 0;
+		for (const auto& line : input)
+		{
+			width = std::max(width, static_cast<uint32_t>(line.size()));
+		}
+
+		labels.assign(static_cast<size_t>(width) * height, NO_SPAN);
+
+		for (uint32_t y = 0; y < height; y++)
+		{
+			const std::string& line = input[y];
+			uint32_t x = 0;
+			while (x < line.size())
+			{
+				char c = line[x];
+				if (!IsSchematicDigit(c))
+				{
+					if (IsSchematicSymbol(c))
+					{
+						symbols.push_back({ y, x, c });
+					}
+					x++;
+					continue;
+				}
+
+				NumberSpan span = { 0, y, x, x };
+				uint32_t spanID = static_cast<uint32_t>(spans.size());
+				while (span.end < line.size() && IsSchematicDigit(line[span.end]))
+				{
+					span.value = span.value * 10 + static_cast<uint32_t>(line[span.end] - '0');
+					labels[Cell(span.end, y)] = spanID;
+					span.end++;
+				}
+
+				spans.push_back(span);
+				x = span.end;
+			}
+		}
+	}
+
+	uint32_t GetWidth() const { return width; }
+	uint32_t GetHeight() const { return height; }
+	const std::vector<NumberSpan>& GetSpans() const { return spans; }
+	const std::vector<SymbolCell>& GetSymbols() const { return symbols; }
+
+	uint32_t GetLabel(int64_t x, int64_t y) const
+	{
+		if (x < 0 || y < 0 || x >= width || y >= height)
+		{
+			return NO_SPAN;
+		}
+		return labels[Cell(static_cast<uint32_t>(x), static_cast<uint32_t>(y))];
+	}
+
+	// Distinct spans in the 3x3 block around a cell, in row-major order of first appearance. A span covers at most 3
+	// cells of any row of the block, so there can't be more than 6 of them. Returns how many were written
+	uint32_t GetAdjacentSpans(uint32_t x, uint32_t y, uint32_t out_spans[6]) const
+	{
+		uint32_t count = 0;
+		for (int64_t dy = -1; dy <= 1; dy++)
+		{
+			uint32_t previous = NO_SPAN;
+			for (int64_t dx = -1; dx <= 1; dx++)
+			{
+				uint32_t label = GetLabel(static_cast<int64_t>(x) + dx, static_cast<int64_t>(y) + dy);
+
+				// A span's cells in one row are contiguous, so comparing against the left neighbor is enough
+				if (label != NO_SPAN && label != previous)
+				{
+					out_spans[count++] = label;
+				}
+				previous = label;
+			}
+		}
+		return count;
+	}
+
+private:
+
+	size_t Cell(uint32_t x, uint32_t y) const
+	{
+		return static_cast<size_t>(y) * width + x;
+	}
+
+	uint32_t width;
+	uint32_t height;
+
+	// One span id per cell, NO_SPAN for everything that isn't a digit
+	std::vector<uint32_t> labels;
+	std::vector<NumberSpan> spans;
+	std::vector<SymbolCell> symbols;
+};
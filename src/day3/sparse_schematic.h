@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "../challenge.h"
+#include "row_runs.h"
+
+// Day 3 for schematics that are mostly '.'. Only the runs are kept: every digit run as a NumberSpan and every symbol
+// as a SymbolCell, all rows back to back in two flat arrays, with per-row offsets into them. The '.' cells are just the
+// gaps between runs, so memory follows the number of non-empty cells instead of the grid area, and both answers are the
+// three-row merges of row_runs.h, which only ever look at runs.
+//
+// Rows can be added one at a time, so the text of the whole schematic never has to be in memory at once
+class SparseSchematic
+{
+public:
+
+	SparseSchematic()
+	{
+		numberOffsets.push_back(0);
+		symbolOffsets.push_back(0);
+	}
+
+	SparseSchematic(const Challenge::Input& input) : SparseSchematic()
+	{
+		numberOffsets.reserve(input.size() + 1);
+		symbolOffsets.reserve(input.size() + 1);
+		for (const auto& line : input)
+		{
+			AddRow(line);
+		}
+	}
+
+	void AddRow(std::string_view line)
+	{
+		ScanSchematicRow(line, GetHeight(), scratch);
+		numbers.insert(numbers.end(), scratch.numbers.begin(), scratch.numbers.end());
+		symbols.insert(symbols.end(), scratch.symbols.begin(), scratch.symbols.end());
+		numberOffsets.push_back(static_cast<uint32_t>(numbers.size()));
+		symbolOffsets.push_back(static_cast<uint32_t>(symbols.size()));
+	}
+
+	// Drops the spare capacity left over from adding rows
+	void ShrinkToFit()
+	{
+		numbers.shrink_to_fit();
+		symbols.shrink_to_fit();
+		numberOffsets.shrink_to_fit();
+		symbolOffsets.shrink_to_fit();
+		scratch = SchematicRow();
+	}
+
+	uint32_t GetHeight() const { return static_cast<uint32_t>(numberOffsets.size() - 1); }
+	size_t GetNumberCount() const { return numbers.size(); }
+	size_t GetSymbolCount() const { return symbols.size(); }
+
+	SchematicRowView GetRow(uint32_t y) const
+	{
+		SchematicRowView row;
+		row.numbers = { numbers.data() + numberOffsets[y], numberOffsets[y + 1] - numberOffsets[y] };
+		row.symbols = { symbols.data() + symbolOffsets[y], symbolOffsets[y + 1] - symbolOffsets[y] };
+		return row;
+	}
+
+	uint64_t SumPartNumbers() const
+	{
+		uint64_t sum = 0;
+		ForEachRowWindow([&sum](const SchematicRowView& row, const SchematicRowView* above, const SchematicRowView* below)
+		{
+			if (!row.numbers.empty()) sum += SumRowPartNumbers(row, above, below);
+		});
+		return sum;
+	}
+
+	uint64_t SumGearRatios() const
+	{
+		uint64_t sum = 0;
+		ForEachRowWindow([&sum](const SchematicRowView& row, const SchematicRowView* above, const SchematicRowView* below)
+		{
+			if (!row.symbols.empty()) sum += SumRowGearRatios(row, above, below);
+		});
+		return sum;
+	}
+
+private:
+
+	// Calls onRow(row, above, below) for every row, above and below being nullptr at the edges
+	template<typename RowHandler>
+	void ForEachRowWindow(RowHandler&& onRow) const
+	{
+		uint32_t height = GetHeight();
+		for (uint32_t y = 0; y < height; y++)
+		{
+			SchematicRowView row = GetRow(y);
+			SchematicRowView above = y > 0 ? GetRow(y - 1) : SchematicRowView();
+			SchematicRowView below = y + 1 < height ? GetRow(y + 1) : SchematicRowView();
+			onRow(row, y > 0 ? &above : nullptr, y + 1 < height ? &below : nullptr);
+		}
+	}
+
+	// Runs of all rows back to back, row y being [offsets[y], offsets[y + 1])
+	std::vector<NumberSpan> numbers;
+	std::vector<SymbolCell> symbols;
+	std::vector<uint32_t> numberOffsets;
+	std::vector<uint32_t> symbolOffsets;
+
+	// Reused by AddRow so scanning doesn't allocate per row
+	SchematicRow scratch;
+};
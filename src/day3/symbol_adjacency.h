@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "schematic_index.h"
+
+// Symbol to span adjacency of a SchematicIndex, computed once and stored in CSR form: the spans around symbol i are
+// spanIDs[offsets[i], offsets[i + 1]). Symbols are also grouped by (character, neighbor count), so every query below
+// only visits the symbols and spans that make up its answer, whatever variant of the Day 3 question is asked.
+//
+// The index is only referenced, not copied, so it has to outlive the object. SumAdjacentTo reuses a scratch buffer,
+// so one object can't be queried from several threads at once
+class SymbolAdjacency
+{
+public:
+
+	// A span covers at most 3 cells of any row of a symbol's 3x3 block
+	static constexpr uint32_t MAX_NEIGHBORS = 6;
+
+	SymbolAdjacency(const SchematicIndex& _index) : index(_index)
+	{
+		const std::vector<SymbolCell>& symbols = index.GetSymbols();
+
+		offsets.reserve(symbols.size() + 1);
+		offsets.push_back(0);
+		spanIDs.reserve(symbols.size() * 2);
+		for (const auto& symbol : symbols)
+		{
+			uint32_t adjacent[MAX_NEIGHBORS];
+			uint32_t count = index.GetAdjacentSpans(symbol.column, symbol.row, adjacent);
+			spanIDs.insert(spanIDs.end(), adjacent, adjacent + count);
+			offsets.push_back(static_cast<uint32_t>(spanIDs.size()));
+		}
+
+		// Counting sort of the symbols by group, which keeps them in schematic order inside each group
+		groupOffsets.assign(GROUP_COUNT + 1, 0);
+		for (uint32_t i = 0; i < symbols.size(); i++)
+		{
+			groupOffsets[Group(symbols[i].symbol, GetNeighborCount(i)) + 1]++;
+		}
+		for (size_t group = 0; group < GROUP_COUNT; group++)
+		{
+			groupOffsets[group + 1] += groupOffsets[group];
+		}
+
+		groupedSymbols.resize(symbols.size());
+		std::vector<uint32_t> cursors(groupOffsets.begin(), groupOffsets.end() - 1);
+		for (uint32_t i = 0; i < symbols.size(); i++)
+		{
+			groupedSymbols[cursors[Group(symbols[i].symbol, GetNeighborCount(i))]++] = i;
+		}
+
+		stamps.assign(index.GetSpans().size(), 0);
+	}
+
+	const SchematicIndex& GetIndex() const { return index; }
+
+	// Neighbors of the symbol at position i of SchematicIndex::GetSymbols()
+	uint32_t GetNeighborCount(uint32_t symbol) const { return offsets[symbol + 1] - offsets[symbol]; }
+	const uint32_t* GetNeighbors(uint32_t symbol) const { return spanIDs.data() + offsets[symbol]; }
+
+	// Calls onSymbol(uint32_t symbol) for every symbol drawn as c with exactly neighborCount spans around it
+	template<typename SymbolHandler>
+	void ForEachSymbol(char c, uint32_t neighborCount, SymbolHandler&& onSymbol) const
+	{
+		if (neighborCount > MAX_NEIGHBORS)
+		{
+			return;
+		}
+
+		size_t group = Group(c, neighborCount);
+		for (uint32_t i = groupOffsets[group]; i < groupOffsets[group + 1]; i++)
+		{
+			onSymbol(groupedSymbols[i]);
+		}
+	}
+
+	// Sum of the spans next to at least one symbol drawn as any character of symbolSet, each span counted once. Part 1
+	// is the same question asked for every symbol character
+	uint64_t SumAdjacentTo(std::string_view symbolSet) const
+	{
+		// Spans stamped with the current stamp were already counted by this query. Stamps only need resetting when the
+		// counter wraps around
+		if (++stamp == 0)
+		{
+			std::fill(stamps.begin(), stamps.end(), 0);
+			stamp = 1;
+		}
+
+		const std::vector<NumberSpan>& spans = index.GetSpans();
+		uint64_t sum = 0;
+		bool seen[256] = {};
+		for (char c : symbolSet)
+		{
+			// Duplicate characters in the set would otherwise visit their groups twice
+			if (seen[static_cast<unsigned char>(c)]) continue;
+			seen[static_cast<unsigned char>(c)] = true;
+
+			for (uint32_t count = 1; count <= MAX_NEIGHBORS; count++)
+			{
+				ForEachSymbol(c, count, [&](uint32_t symbol)
+				{
+					const uint32_t* neighbors = GetNeighbors(symbol);
+					for (uint32_t n = 0; n < count; n++)
+					{
+						if (stamps[neighbors[n]] != stamp)
+						{
+							stamps[neighbors[n]] = stamp;
+							sum += spans[neighbors[n]].value;
+						}
+					}
+				});
+			}
+		}
+
+		return sum;
+	}
+
+	// Sum over the symbols drawn as c with exactly neighborCount spans around them, of the product of those spans.
+	// Part 2 is SumGearRatios('*', 2)
+	uint64_t SumGearRatios(char c = '*', uint32_t neighborCount = 2) const
+	{
+		const std::vector<NumberSpan>& spans = index.GetSpans();
+		uint64_t sum = 0;
+		ForEachSymbol(c, neighborCount, [&](uint32_t symbol)
+		{
+			const uint32_t* neighbors = GetNeighbors(symbol);
+			uint64_t ratio = 1;
+			for (uint32_t n = 0; n < neighborCount; n++)
+			{
+				ratio *= spans[neighbors[n]].value;
+			}
+			sum += ratio;
+		});
+		return sum;
+	}
+
+private:
+
+	static constexpr size_t GROUP_COUNT = 256 * (MAX_NEIGHBORS + 1);
+
+	static size_t Group(char c, uint32_t neighborCount)
+	{
+		return static_cast<size_t>(static_cast<unsigned char>(c)) * (MAX_NEIGHBORS + 1) + neighborCount;
+	}
+
+	const SchematicIndex& index;
+
+	// CSR adjacency, one row per symbol of the index
+	std::vector<uint32_t> offsets;
+	std::vector<uint32_t> spanIDs;
+
+	// Symbol positions sorted by group, group g being groupedSymbols[groupOffsets[g], groupOffsets[g + 1])
+	std::vector<uint32_t> groupOffsets;
+	std::vector<uint32_t> groupedSymbols;
+
+	mutable std::vector<uint32_t> stamps;
+	mutable uint32_t stamp = 0;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 128-bit totals, for card sets whose copy counts don't fit in 64 bits (they can grow exponentially with the length of
+// winning chains). Only where the compiler has a native 128-bit integer
+#if defined(__SIZEOF_INT128__)
+#define AOC_HAS_CARD_COUNT_128 1
+__extension__ typedef unsigned __int128 CardCount128;
+#endif
+
+// Day 4 part 2 without ever creating a card copy. Card i ends up with 1 + (copies won from earlier cards) instances, and
+// all of them win the same next matches[i] cards, so it hands copies[i] to the range [i + 1, i + matches[i]]. Ranges are
+// added to a difference array and the running sum of that array is the number of copies won by the current card, which
+// makes the sweep O(cards) with one counter per card, whatever the number of copies. Ranges past the last card are cut
+// off there.
+//
+// Count is the type of the totals: uint64_t, CardCount128, or anything else with + and -. Unsigned types wrap around
+template<typename Count = uint64_t>
+Count CountTotalCards(const uint32_t* matches, size_t cardCount)
+{
+	std::vector<Count> pending(cardCount + 1, Count(0));
+
+	Count total = 0;
+	Count won = 0;
+	for (size_t i = 0; i < cardCount; i++)
+	{
+		won += pending[i];
+		Count copies = won + Count(1);
+		total += copies;
+
+		size_t end = i + 1 + matches[i];
+		if (end > cardCount) end = cardCount;
+		if (end > i + 1)
+		{
+			pending[i + 1] += copies;
+			pending[end] -= copies;
+		}
+	}
+
+	return total;
+}
+
+template<typename Count = uint64_t>
+Count CountTotalCards(const std::vector<uint32_t>& matches)
+{
+	return CountTotalCards<Count>(matches.data(), matches.size());
+}
@@ -33,78 +33,47 @@
 // Take a seat in the large pile of colorful cards.How many points are they worth in total ?
 
 #include "../challenge.h"
+#include "../output.h"
+#include "scratchcard.h"
 
-struct Day4_1 : public Challenge
+// Adds every card of the input to the batch, skipping empty lines. Any other line that can't be read as a card fails the
+// whole input: dropping it would shift the copies every later card wins in part 2
+inline bool AddScratchcards(const Challenge::Input& input, ScratchcardBatch& out_cards)
 {
-	void ConvertStringToNumbers(std::string line, std::vector<int>& out_result)
+	out_cards.Reserve(input.size());
+	for (size_t i = 0; i < input.size(); i++)
 	{
-		std::string currentNum = "";
-		for (const auto& c : line)
-		{
-			if (c == ' ')
-			{
-				if (!currentNum.empty())
-				{
-					out_result.push_back(std::atoi(currentNum.c_str()));
-					currentNum.clear();
-				}
-				continue;
-			}
-
-			currentNum += c;
-		}
-
-		// Get the last number
-		if (!currentNum.empty())
+		if (!input[i].empty() && !out_cards.AddCard(input[i]))
 		{
-			out_result.push_back(std::atoi(currentNum.c_str()));
+			Diag() << "[ERROR] Line " << (i + 1) << " isn't a card with numbers below " << ScratchcardNumbers::WORD_COUNT * 64 << ": '" << input[i] << "'" << '\n';
+			return false;
 		}
 	}
+	return true;
+}
 
+struct Day4_1 : public Challenge
+{
 	int Run(Input input)
 	{
-		int sum = 0;
-
-		for (const auto& line : input)
+		ScratchcardBatch cards;
+		if (!AddScratchcards(input, cards))
 		{
-			std::string game = line;
-
-			int startIndex = game.find(':') + 2;
-			game = game.substr(startIndex, game.size() - startIndex);
-
-			int barDivisionIndex = game.find('|');
-
-			std::string winningNumbersStr = game.substr(0, barDivisionIndex - 1);
-			std::string personalNumbersStr = game.substr(barDivisionIndex + 2, game.size() - (barDivisionIndex - 2));
-
-			std::vector<int> winningNumbers;
-			std::vector<int> personalNumbers;
-
-			ConvertStringToNumbers(winningNumbersStr, winningNumbers);
-			ConvertStringToNumbers(personalNumbersStr, personalNumbers);
-
-			int matches = 0;
-			for (const auto& personalNumber : personalNumbers)
-			{
-				for (const auto& winningNumber : winningNumbers)
-				{
-					if (winningNumber == personalNumber)
-					{
-						matches++;
-						break; // Go to next personal number
-					}
-				}
-			}
+			return -1;
+		}
 
+		uint64_t sum = 0;
+		for (const auto& matches : cards.CountMatches())
+		{
+			// The first match is worth one point, every match after it doubles that. Saturates at 2^63
 			if (matches > 0)
 			{
-				int points = pow(2, matches - 1);
-				sum += points;
-				std::cout << line << " | " << matches << " matches, worth " << points << " points!" << std::endl;
+				sum += uint64_t(1) << std::min<uint32_t>(matches - 1, 63);
 			}
 		}
 
-		return sum;
+		Diag() << cards.GetCardCount() << " cards, worth " << sum << " points" << '\n';
+		return static_cast<int>(sum);
 	}
 };
 
@@ -136,112 +105,23 @@ struct Day4_1 : public Challenge
 // 
 // Process all of the original and copied scratchcards until no more scratchcards are won.Including the original set of scratchcards, how many total scratchcards do you end up with ?
 
-#include <queue>
-#include <unordered_map>
+#include "card_copies.h"
 
 struct Day4_2 : public Challenge
 {
-	void ConvertStringToNumbers(std::string line, std::vector<int>& out_result)
-	{
-		std::string currentNum = "";
-		for (const auto& c : line)
-		{
-			if (c == ' ')
-			{
-				if (!currentNum.empty())
-				{
-					out_result.push_back(std::atoi(currentNum.c_str()));
-					currentNum.clear();
-				}
-				continue;
-			}
-
-			currentNum += c;
-		}
-
-		// Get the last number
-		if (!currentNum.empty())
-		{
-			out_result.push_back(std::atoi(currentNum.c_str()));
-		}
-	}
-
-	void PushWinners(int winningNumber, int count, std::queue<int>& queue)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			int newWinner = winningNumber + i + 1;
-			queue.push(newWinner);
-		}
-	}
-
 	int Run(Input input)
 	{
-		std::unordered_map<int, int> cardIDToWinnersMap;
-		std::queue<int> traversalQueue;
-
-		for (const auto& line : input)
+		ScratchcardBatch cards;
+		if (!AddScratchcards(input, cards))
 		{
-			std::string game = line;
-
-			int cardID = -1;
-
-			int startIndex = game.find(':') + 2;
-
-			// Get the card ID
-			std::string cardIDStr = game.substr(4, startIndex - 2);
-			std::vector<int> cardIDVec;
-			ConvertStringToNumbers(cardIDStr, cardIDVec);
-			cardID = cardIDVec[0];
-
-			game = game.substr(startIndex, game.size() - startIndex);
-
-			int barDivisionIndex = game.find('|');
-
-			std::string winningNumbersStr = game.substr(0, barDivisionIndex - 1);
-			std::string personalNumbersStr = game.substr(barDivisionIndex + 2, game.size() - (barDivisionIndex - 2));
-
-			std::vector<int> winningNumbers;
-			std::vector<int> personalNumbers;
-
-			ConvertStringToNumbers(winningNumbersStr, winningNumbers);
-			ConvertStringToNumbers(personalNumbersStr, personalNumbers);
-
-			int matches = 0;
-			for (const auto& personalNumber : personalNumbers)
-			{
-				for (const auto& winningNumber : winningNumbers)
-				{
-					if (winningNumber == personalNumber)
-					{
-						matches++;
-						break; // Go to next personal number
-					}
-				}
-			}
-
-			traversalQueue.push(cardID);
-
-			// Insert the card ID along with all of it's winners into the map
-			cardIDToWinnersMap.insert({ cardID, matches });
+			return -1;
 		}
 
-		int sum = 0;
-		while (!traversalQueue.empty())
-		{
-			// Get the first element
-			int id = traversalQueue.front();
-
-			// Push it's winners to the back of the queue
-			int winners = cardIDToWinnersMap.at(id);
-			PushWinners(id, winners, traversalQueue);
-
-			// Pop the current card off
-			traversalQueue.pop();
+		// Cards are in ID order, so the match counts in input order are all the copy counting needs
+		std::vector<uint32_t> cardMatches = cards.CountMatches();
 
-			sum++;
-		}
-
-		return sum;
+		uint64_t totalCards = CountTotalCards(cardMatches);
+		Diag() << cardMatches.size() << " cards, " << totalCards << " cards in total after copies" << '\n';
+		return static_cast<int>(totalCards);
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../challenge.h"
+#include "../thread_pool.h"
+#include "scratchcard.h"
+
+struct Day4Sums
+{
+	uint64_t points = 0;
+	uint64_t totalCards = 0;
+};
+
+// Both Day 4 questions over a large card set on the thread pool, in two stages.
+//
+// First the lines are cut into fixed blocks, and each task parses and scores its own block. That gives the match count
+// of every card, the points, and the highest match count W.
+//
+// Then the copy counting of CountTotalCards runs as a blocked scan over the match counts. What a block does only depends
+// on the copies its first W cards already won from earlier blocks (nothing earlier reaches further), and it's linear in
+// them. So each task sweeps its block once, carrying a vector of W + 1 coefficients per count instead of a number: one
+// per incoming count plus a constant. What comes out is the block as an affine map, from the W incoming counts to the
+// block's card total and to the W counts it hands to the next block. Chaining those maps on the calling thread is
+// O(W^2) per block.
+//
+// Empty lines are skipped like in Day4_1. Any other line that can't be read as a card makes Evaluate return false, as
+// dropping it would shift every copy count after it.
+//
+// Every count is a uint64_t, and all of this is exact in wrap-around arithmetic, so the result always matches the
+// sequential sweep. A block sweep costs about W + 1 times the sequential one, so the scan only wins once there are more
+// cores than that.
+//
+// This waits on the pool, so it must not be called from inside a pool task (like a batch item in the runner)
+class Day4Engine
+{
+public:
+
+	static constexpr size_t DEFAULT_BLOCK_LINES = 4096;
+	static constexpr size_t DEFAULT_BLOCK_CARDS = 65536;
+
+	static bool Evaluate(const Challenge::Input& input, ThreadPool& pool, Day4Sums& out_sums, size_t blockLines = DEFAULT_BLOCK_LINES, size_t blockCards = DEFAULT_BLOCK_CARDS)
+	{
+		blockLines = std::max<size_t>(blockLines, 1);
+		size_t blockCount = (input.size() + blockLines - 1) / blockLines;
+
+		// One cache line per block, so neighbouring tasks never write to the same line
+		struct alignas(64) BlockScores
+		{
+			std::vector<uint32_t> matches;
+			uint64_t points = 0;
+			bool valid = true;
+		};
+		std::vector<BlockScores> blockScores(blockCount);
+
+		pool.ParallelFor(blockCount, [&](size_t block)
+		{
+			size_t begin = block * blockLines;
+			size_t end = std::min(input.size(), begin + blockLines);
+
+			ScratchcardBatch cards;
+			cards.Reserve(end - begin);
+			BlockScores& scores = blockScores[block];
+			for (size_t line = begin; line < end; line++)
+			{
+				if (!input[line].empty() && !cards.AddCard(input[line]))
+				{
+					scores.valid = false;
+					return;
+				}
+			}
+
+			scores.matches = cards.CountMatches();
+			for (const auto& matches : scores.matches)
+			{
+				if (matches > 0)
+				{
+					scores.points += uint64_t(1) << std::min<uint32_t>(matches - 1, 63);
+				}
+			}
+		}, "Day4 score block");
+
+		Day4Sums sums;
+		std::vector<uint32_t> cardMatches;
+		for (const auto& block : blockScores)
+		{
+			if (!block.valid)
+			{
+				return false;
+			}
+
+			sums.points += block.points;
+			cardMatches.insert(cardMatches.end(), block.matches.begin(), block.matches.end());
+		}
+
+		sums.totalCards = CountTotalCards(cardMatches, pool, blockCards);
+		out_sums = sums;
+		return true;
+	}
+
+	// Parallel version of CountTotalCards(matches) from card_copies.h
+	static uint64_t CountTotalCards(const std::vector<uint32_t>& matches, ThreadPool& pool, size_t blockCards = DEFAULT_BLOCK_CARDS)
+	{
+		blockCards = std::max<size_t>(blockCards, 1);
+		size_t blockCount = (matches.size() + blockCards - 1) / blockCards;
+
+		// Nothing is ever won further ahead than the highest match count
+		uint32_t window = 0;
+		for (const auto& count : matches)
+		{
+			window = std::max(window, count);
+		}
+
+		std::vector<BlockMap> blockMaps(blockCount);
+		pool.ParallelFor(blockCount, [&](size_t block)
+		{
+			size_t begin = block * blockCards;
+			size_t end = std::min(matches.size(), begin + blockCards);
+			blockMaps[block] = SweepBlock(&matches[begin], end - begin, window);
+		}, "Day4 copy block");
+
+		// Chain the maps: incoming holds the copies the next W cards already won from all blocks so far
+		size_t width = static_cast<size_t>(window) + 1;
+		std::vector<uint64_t> incoming(window, 0);
+		std::vector<uint64_t> outgoing(window, 0);
+		uint64_t total = 0;
+		for (const auto& map : blockMaps)
+		{
+			total += Apply(map.total.data(), incoming);
+			for (size_t j = 0; j < window; j++)
+			{
+				outgoing[j] = Apply(&map.outgoing[j * width], incoming);
+			}
+			std::swap(incoming, outgoing);
+		}
+
+		return total;
+	}
+
+private:
+
+	// A block as an affine map of the W counts coming in. Every output is W + 1 coefficients: one per incoming count,
+	// then the constant
+	struct alignas(64) BlockMap
+	{
+		std::vector<uint64_t> total;
+		std::vector<uint64_t> outgoing;
+	};
+
+	static uint64_t Apply(const uint64_t* coefficients, const std::vector<uint64_t>& incoming)
+	{
+		uint64_t value = coefficients[incoming.size()];
+		for (size_t j = 0; j < incoming.size(); j++)
+		{
+			value += coefficients[j] * incoming[j];
+		}
+		return value;
+	}
+
+	// The sweep of CountTotalCards over one block, with coefficient vectors for counts. Pending copies live in a ring
+	// buffer like in ScratchcardStream, as nothing is pending more than W cards ahead
+	static BlockMap SweepBlock(const uint32_t* matches, size_t count, uint32_t window)
+	{
+		size_t width = static_cast<size_t>(window) + 1;
+		size_t ringSize = 1;
+		while (ringSize < static_cast<size_t>(window) + 2)
+		{
+			ringSize *= 2;
+		}
+
+		std::vector<uint64_t> pending(ringSize * width, 0);
+		std::vector<uint64_t> won(width, 0);
+		std::vector<uint64_t> copies(width);
+
+		BlockMap map;
+		map.total.assign(width, 0);
+		map.outgoing.assign(window * width, 0);
+
+		for (size_t card = 0; card < count; card++)
+		{
+			uint64_t* slot = &pending[(card & (ringSize - 1)) * width];
+			for (size_t k = 0; k < width; k++)
+			{
+				won[k] += slot[k];
+				slot[k] = 0;
+			}
+
+			// The card itself, plus whatever it won from earlier blocks
+			copies = won;
+			copies[window] += 1;
+			if (card < window)
+			{
+				copies[card] += 1;
+			}
+
+			for (size_t k = 0; k < width; k++)
+			{
+				map.total[k] += copies[k];
+			}
+
+			if (matches[card] > 0)
+			{
+				uint64_t* first = &pending[((card + 1) & (ringSize - 1)) * width];
+				uint64_t* last = &pending[((card + 1 + matches[card]) & (ringSize - 1)) * width];
+				for (size_t k = 0; k < width; k++)
+				{
+					first[k] += copies[k];
+					last[k] -= copies[k];
+				}
+			}
+		}
+
+		// The copies the next W cards won, from this block and from earlier blocks when the block is shorter than W
+		for (size_t j = 0; j < window; j++)
+		{
+			size_t card = count + j;
+			uint64_t* slot = &pending[(card & (ringSize - 1)) * width];
+			uint64_t* out = &map.outgoing[j * width];
+			for (size_t k = 0; k < width; k++)
+			{
+				won[k] += slot[k];
+				slot[k] = 0;
+				out[k] = won[k];
+			}
+
+			if (card < window)
+			{
+				out[card] += 1;
+			}
+		}
+
+		return map;
+	}
+};
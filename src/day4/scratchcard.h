@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+inline uint32_t PopCount64(uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	return static_cast<uint32_t>(__popcnt64(value));
+#elif defined(_MSC_VER)
+	return __popcnt(static_cast<uint32_t>(value)) + __popcnt(static_cast<uint32_t>(value >> 32));
+#else
+	return static_cast<uint32_t>(__builtin_popcountll(value));
+#endif
+}
+
+// Set of the small numbers printed on a scratchcard, one bit per number in [0, Bits). The match count of a card is
+// then the size of the intersection of its two sets: one AND and one popcount per 64 numbers.
+//
+// A set can't hold the same number twice. The puzzle never repeats a number on either side of a card, which is what
+// makes this the same as counting the personal numbers that appear among the winning ones
+template<size_t Bits = 128>
+struct NumberSet
+{
+	static constexpr size_t WORD_COUNT = (Bits + 63) / 64;
+
+	alignas(16) uint64_t words[WORD_COUNT] = {};
+
+	// Returns false if the number doesn't fit the set
+	bool Add(uint32_t number)
+	{
+		if (number >= Bits)
+		{
+			return false;
+		}
+
+		words[number / 64] |= uint64_t(1) << (number % 64);
+		return true;
+	}
+
+	bool Contains(uint32_t number) const
+	{
+		return number < Bits && (words[number / 64] >> (number % 64)) & 1;
+	}
+
+	uint32_t CountCommon(const NumberSet& other) const
+	{
+		uint32_t count = 0;
+		for (size_t w = 0; w < WORD_COUNT; w++)
+		{
+			count += PopCount64(words[w] & other.words[w]);
+		}
+		return count;
+	}
+};
+
+// Parses "Card <id>: <winning numbers> | <personal numbers>" into the two sets. Returns false for lines that aren't
+// cards, and for cards with a number that doesn't fit the sets
+template<size_t Bits>
+bool ParseScratchcard(std::string_view line, NumberSet<Bits>& out_winning, NumberSet<Bits>& out_personal)
+{
+	size_t colon = line.find(':');
+	if (colon == std::string_view::npos)
+	{
+		return false;
+	}
+
+	NumberSet<Bits>* current = &out_winning;
+	bool afterBar = false;
+	uint32_t number = 0;
+	bool inNumber = false;
+	for (size_t i = colon + 1; i <= line.size(); i++)
+	{
+		// One past the end acts as a separator, to finish the last number
+		char c = i < line.size() ? line[i] : ' ';
+		if (c >= '0' && c <= '9')
+		{
+			// Anything this large doesn't fit any set, just keep it from wrapping around
+			number = number < UINT32_MAX / 10 ? number * 10 + static_cast<uint32_t>(c - '0') : UINT32_MAX;
+			inNumber = true;
+			continue;
+		}
+
+		if (inNumber)
+		{
+			if (!current->Add(number))
+			{
+				return false;
+			}
+			number = 0;
+			inNumber = false;
+		}
+
+		if (c == '|')
+		{
+			if (afterBar)
+			{
+				return false;
+			}
+			current = &out_personal;
+			afterBar = true;
+		}
+	}
+
+	return afterBar;
+}
+
+typedef NumberSet<128> ScratchcardNumbers;
+
+// Winning and personal sets of many cards, in input order, for scoring them all in one go. With AVX2 two cards fit in
+// a register: the popcount is done per nibble with a shuffle lookup, and summed per card by a sum of absolute
+// differences against zero. Without it, one scalar popcount per word
+class ScratchcardBatch
+{
+public:
+
+	// Parses a card and appends it. Lines that aren't cards are skipped
+	bool AddCard(std::string_view line)
+	{
+		ScratchcardNumbers winningNumbers;
+		ScratchcardNumbers personalNumbers;
+		if (!ParseScratchcard(line, winningNumbers, personalNumbers))
+		{
+			return false;
+		}
+
+		winning.push_back(winningNumbers);
+		personal.push_back(personalNumbers);
+		return true;
+	}
+
+	void Reserve(size_t count)
+	{
+		winning.reserve(count);
+		personal.reserve(count);
+	}
+
+	size_t GetCardCount() const { return winning.size(); }
+
+	// Match counts of the cards in [begin, end), written to out_matches[0, end - begin)
+	void CountMatches(uint32_t* out_matches, size_t begin = 0, size_t end = SIZE_MAX) const
+	{
+		end = std::min(end, winning.size());
+		begin = std::min(begin, end);
+
+		size_t card = begin;
+
+#if defined(__AVX2__)
+		const __m256i nibbleCounts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+		const __m256i zero = _mm256_setzero_si256();
+		for (; card + 2 <= end; card += 2)
+		{
+			__m256i common = _mm256_and_si256(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&winning[card])),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&personal[card])));
+
+			__m256i low = _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(common, lowNibbles));
+			__m256i high = _mm256_shuffle_epi8(nibbleCounts, _mm256_and_si256(_mm256_srli_epi16(common, 4), lowNibbles));
+
+			// One count per 64-bit lane, two lanes per card
+			__m256i counts = _mm256_sad_epu8(_mm256_add_epi8(low, high), zero);
+			counts = _mm256_add_epi64(counts, _mm256_shuffle_epi32(counts, 0x4E));
+
+			out_matches[card - begin] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_castsi256_si128(counts)));
+			out_matches[card + 1 - begin] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_extracti128_si256(counts, 1)));
+		}
+#endif
+
+		for (; card < end; card++)
+		{
+			out_matches[card - begin] = winning[card].CountCommon(personal[card]);
+		}
+	}
+
+	std::vector<uint32_t> CountMatches() const
+	{
+		std::vector<uint32_t> matches(winning.size());
+		CountMatches(matches.data());
+		return matches;
+	}
+
+private:
+
+	static_assert(sizeof(ScratchcardNumbers) == 16, "two sets per 256-bit register");
+
+	std::vector<ScratchcardNumbers> winning;
+	std::vector<ScratchcardNumbers> personal;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include "scratchcard.h"
+
+struct ScratchcardTotals
+{
+	uint64_t cards = 0;
+	uint64_t points = 0;
+	uint64_t totalCards = 0;
+};
+
+// Both Day 4 questions over a stream of cards, in O(1) memory. A card only ever hands copies to the next matches cards,
+// and matches can't be more than the numbers a set can hold, so the difference array of CountTotalCards only needs a
+// window that far ahead of the current card. It lives in a ring buffer: the slot of the current card is read and
+// cleared, and the card adds its copies to the slots of the cards it wins. Totals are updated after every card, so
+// they're always those of the cards seen so far (and copies won past the last card so far are not counted yet).
+//
+// Totals are 64 bits and wrap around
+class ScratchcardStream
+{
+public:
+
+	// Power of two larger than 1 + the highest possible match count, so the slot a card writes past its last won card
+	// never reaches back around to a slot that's still pending
+	static constexpr size_t WINDOW = 256;
+	static_assert(WINDOW > ScratchcardNumbers::WORD_COUNT * 64 + 1, "window must cover the highest match count");
+	static_assert((WINDOW & (WINDOW - 1)) == 0, "window must be a power of two");
+
+	// Parses a card and counts it. Returns false, without counting anything, for a line that isn't a card or has a
+	// number that doesn't fit ScratchcardNumbers
+	bool AddCard(std::string_view line)
+	{
+		ScratchcardNumbers winning;
+		ScratchcardNumbers personal;
+		if (!ParseScratchcard(line, winning, personal))
+		{
+			return false;
+		}
+
+		return AddMatches(winning.CountCommon(personal));
+	}
+
+	// Counts a card that was already scored. Returns false, without counting it, for a match count the window can't
+	// hold (more than any card parsed into ScratchcardNumbers can have)
+	bool AddMatches(uint32_t matches)
+	{
+		if (matches > WINDOW - 2)
+		{
+			return false;
+		}
+
+		if (matches > 0)
+		{
+			totals.points += uint64_t(1) << (matches - 1 < 63 ? matches - 1 : 63);
+		}
+
+		won += pending[position];
+		pending[position] = 0;
+
+		uint64_t copies = won + 1;
+		totals.totalCards += copies;
+		totals.cards++;
+
+		if (matches > 0)
+		{
+			pending[(position + 1) & (WINDOW - 1)] += copies;
+			pending[(position + 1 + matches) & (WINDOW - 1)] -= copies;
+		}
+
+		position = (position + 1) & (WINDOW - 1);
+		return true;
+	}
+
+	// Reads cards line by line until the end of the stream, calling onCard(const ScratchcardTotals&) after each one.
+	// Empty lines are skipped. Any other line that can't be read as a card stops the read and returns false, as skipping
+	// it would shift the copies of every card after it. The cards read so far stay counted in GetTotals()
+	template<typename CardHandler>
+	bool ReadStream(std::istream& stream, CardHandler&& onCard)
+	{
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			if (line.empty()) continue;
+
+			if (!AddCard(line))
+			{
+				return false;
+			}
+			onCard(totals);
+		}
+		return true;
+	}
+
+	bool ReadStream(std::istream& stream)
+	{
+		return ReadStream(stream, [](const ScratchcardTotals&) { });
+	}
+
+	const ScratchcardTotals& GetTotals() const { return totals; }
+
+	void Reset()
+	{
+		*this = ScratchcardStream();
+	}
+
+private:
+
+	// Pending copy counts as a difference array, slot i % WINDOW being card i
+	uint64_t pending[WINDOW] = {};
+	size_t position = 0;
+
+	// Running sum of the difference array up to the current card: the copies it won from earlier cards
+	uint64_t won = 0;
+
+	ScratchcardTotals totals;
+};
@@ -94,6 +94,8 @@
 // What is the lowest location number that corresponds to any of the initial seed numbers ?
 
 #include "../challenge.h"
+#include "../output.h"
+#include "../trace.h"
 
 #include <assert.h>
 #include <algorithm>
@@ -208,7 +210,7 @@ struct Day5_1 : public Challenge
 		for (const auto& seedNumber : seedList)
 		{
 			uint64_t mappedSeedNumber = seedNumber;
-			std::cout << "Start seed: " << seedNumber << std::endl;
+			Diag() << "Start seed: " << seedNumber << '\n';
 			for (const auto& map : MapList)
 			{
 				// Find the mapped number
@@ -222,19 +224,19 @@ struct Day5_1 : public Challenge
 					if (mappedSeedNumber >= src && mappedSeedNumber < src + len)
 					{
 						uint64_t offset = mappedSeedNumber - src;
-						std::cout << "\t" << "Mapped " << mappedSeedNumber << " to " << dest + offset << std::endl;
+						Diag() << "\t" << "Mapped " << mappedSeedNumber << " to " << dest + offset << '\n';
 						mappedSeedNumber = dest + offset;
 						break;
 					}
 				}
 			}
 
-			std::cout << "End seed: " << mappedSeedNumber << std::endl;
+			Diag() << "End seed: " << mappedSeedNumber << '\n';
 			lowestLocation = std::min(lowestLocation, mappedSeedNumber);
-			std::cout << "Lowest: " << lowestLocation << std::endl;
+			Diag() << "Lowest: " << lowestLocation << '\n';
 		}
 
-		std::cout << "Result: " << lowestLocation << std::endl;
+		Diag() << "Result: " << lowestLocation << '\n';
 
 		return lowestLocation;
 	}
@@ -276,6 +278,13 @@ struct Day5_2 : public Challenge
 
 	static void Thread_Calculate(uint64_t start, uint64_t length, const std::vector<MapType>& MapList, uint64_t* out_min)
 	{
+		bool tracing = TraceRecorder::Get().IsEnabled();
+		if (tracing)
+		{
+			TraceRecorder::Get().NameThread("Day5_2 seed range " + std::to_string(start));
+		}
+		ScopedTrace trace("Day5_2 seed range", "solver", tracing ? "start " + std::to_string(start) + ", length " + std::to_string(length) : std::string());
+
 		for (uint64_t i = 0; i < length; i++)
 		{
 			uint64_t mappedSeedNumber = start + i;
@@ -399,7 +408,7 @@ struct Day5_2 : public Challenge
 			lowestLocation = std::min(result, lowestLocation);
 		}
 
-		std::cout << "Result: " << lowestLocation << std::endl;
+		Diag() << "Result: " << lowestLocation << '\n';
 
 		return lowestLocation;
 	}
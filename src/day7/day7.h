@@ -51,6 +51,8 @@
 // Find the rank of every hand in your set. What are the total winnings?
 
 #include "../challenge.h"
+#include "../output.h"
+#include "../trace.h"
 
 #include <assert.h>
 #include <algorithm>
@@ -167,6 +169,7 @@ struct Day7_1 : public Challenge
 	{
 		std::unordered_map<Hand, int> handToBidList;
 
+		ScopedTrace parseTrace("parse", "phase");
 		for (const auto& line : input)
 		{
 			int spaceIndex = line.find(' ');
@@ -174,7 +177,9 @@ struct Day7_1 : public Challenge
 			int bid = std::stoi(line.substr(spaceIndex + 1, line.size()));
 			handToBidList.insert({ hand, bid });
 		}
+		parseTrace.End();
 
+		ScopedTrace classifyTrace("classify", "phase");
 		std::vector<std::vector<Hand>> rankingFirstRule;
 		rankingFirstRule.resize(HandTypes.size());
 
@@ -191,7 +196,7 @@ struct Day7_1 : public Challenge
 				if (func(tally))
 				{
 					// This hand passed the first test, try to rank it
-					std::cout << "Hand '" << hand << "' is " << HandTypeNames[i] << std::endl;
+					Diag() << "Hand '" << hand << "' is " << HandTypeNames[i] << '\n';
 					auto& vec = rankingFirstRule[i];
 					vec.push_back(hand);
 					break;
@@ -199,6 +204,9 @@ struct Day7_1 : public Challenge
 			}
 		}
 
+		classifyTrace.End();
+
+		ScopedTrace sortTrace("sort", "phase");
 		std::vector<Hand> rankingSecondRule;
 		rankingSecondRule.reserve(handToBidList.size());
 
@@ -230,14 +238,18 @@ struct Day7_1 : public Challenge
 			}
 		}
 
+		sortTrace.End();
+
 		// Finally calculate the total winnings
+		ScopedTrace scoreTrace("score", "phase");
 		uint64_t winnings = 0;
 		for (uint64_t i = 0; i < rankingSecondRule.size(); i++)
 		{
 			winnings += (i + 1) * static_cast<uint64_t>(handToBidList[rankingSecondRule[i]]);
 		}
+		scoreTrace.End();
 
-		std::cout << "Real result: " << winnings << std::endl;
+		Diag() << "Real result: " << winnings << '\n';
 
 		return winnings;
 	}
@@ -270,6 +282,7 @@ struct Day7_2 : public Challenge
 	{
 		std::unordered_map<Hand, int> handToBidList;
 
+		ScopedTrace parseTrace("parse", "phase");
 		for (const auto& line : input)
 		{
 			int spaceIndex = line.find(' ');
@@ -277,7 +290,9 @@ struct Day7_2 : public Challenge
 			int bid = std::stoi(line.substr(spaceIndex + 1, line.size()));
 			handToBidList.insert({ hand, bid });
 		}
+		parseTrace.End();
 
+		ScopedTrace classifyTrace("classify", "phase");
 		std::vector<std::vector<Hand>> rankingFirstRule;
 		rankingFirstRule.resize(HandTypes.size());
 
@@ -319,7 +334,7 @@ struct Day7_2 : public Challenge
 							if (func(modifiedTally))
 							{
 								// This hand passed the first test, try to rank it
-								std::cout << "\t" << "[JOKER] Hand '" << hand << "' is " << HandTypeNames[j] << std::endl;
+								Diag() << "\t" << "[JOKER] Hand '" << hand << "' is " << HandTypeNames[j] << '\n';
 								bestRank = std::max(bestRank, j);
 								foundType = true;
 								break;
@@ -333,7 +348,7 @@ struct Day7_2 : public Challenge
 				}
 
 				// Push back the hand only to the best rank
-				std::cout << "Found best joker iteration for hand '" << hand << "' to be " << HandTypeNames[bestRank] << std::endl;
+				Diag() << "Found best joker iteration for hand '" << hand << "' to be " << HandTypeNames[bestRank] << '\n';
 				auto& vec = rankingFirstRule[bestRank];
 				vec.push_back(hand);
 			}
@@ -345,7 +360,7 @@ struct Day7_2 : public Challenge
 					if (func(tally))
 					{
 						// This hand passed the first test, try to rank it
-						std::cout << "Hand '" << hand << "' is " << HandTypeNames[i] << std::endl;
+						Diag() << "Hand '" << hand << "' is " << HandTypeNames[i] << '\n';
 						auto& vec = rankingFirstRule[i];
 						vec.push_back(hand);
 						break;
@@ -355,6 +370,9 @@ struct Day7_2 : public Challenge
 
 		}
 
+		classifyTrace.End();
+
+		ScopedTrace sortTrace("sort", "phase");
 		std::vector<Hand> rankingSecondRule;
 		rankingSecondRule.reserve(handToBidList.size());
 
@@ -386,14 +404,18 @@ struct Day7_2 : public Challenge
 			}
 		}
 
+		sortTrace.End();
+
 		// Finally calculate the total winnings
+		ScopedTrace scoreTrace("score", "phase");
 		uint64_t winnings = 0;
 		for (uint64_t i = 0; i < rankingSecondRule.size(); i++)
 		{
 			winnings += (i + 1) * static_cast<uint64_t>(handToBidList[rankingSecondRule[i]]);
 		}
+		scoreTrace.End();
 
-		std::cout << "Real result: " << winnings << std::endl;
+		Diag() << "Real result: " << winnings << '\n';
 
 		return winnings;
 	}
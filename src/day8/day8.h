@@ -30,6 +30,8 @@
 // Starting at AAA, follow the left/right instructions. How many steps are required to reach ZZZ?
 
 #include "../challenge.h"
+#include "../output.h"
+#include "../trace.h"
 
 #include <string>
 #include <optional>
@@ -190,6 +192,7 @@ struct Day8_2 : public Challenge
 		std::string steps = input[0];
 
 		// First iteration, construct main container and nodeToString
+		ScopedTrace parseTrace("parse", "phase");
 		std::vector<size_t> startingNodes;
 		for (int i = 2; i < input.size(); i++)
 		{
@@ -208,7 +211,9 @@ struct Day8_2 : public Challenge
 			size_t nodeID = i - 2;
 			ParseNeighbors(line, mainContainer[nodeID]);
 		}
+		parseTrace.End();
 
+		ScopedTrace stepTrace("step", "phase");
 		std::vector<size_t> currentNodeIDs = startingNodes;
 		std::vector<size_t> numStepsPerNode;
 		numStepsPerNode.resize(startingNodes.size());
@@ -231,7 +236,7 @@ struct Day8_2 : public Challenge
 
 					stepsTaken++;
 
-					std::cout << nodeIDToString[currNodeID] << " ";
+					Diag() << nodeIDToString[currNodeID] << " ";
 
 					if (mainContainer[currNodeID].isEnd)
 					{
@@ -240,21 +245,23 @@ struct Day8_2 : public Challenge
 					}
 				}
 
-				std::cout << std::endl;
+				Diag() << '\n';
 
 				if (finished)
 				{
-					std::cout << "Node " << nodeIDToString.at(currNodeID) << " finished in " << stepsTaken << " steps!" << std::endl;
+					Diag() << "Node " << nodeIDToString.at(currNodeID) << " finished in " << stepsTaken << " steps!" << '\n';
 					numStepsPerNode[i] = stepsTaken;
 					break;
 				}
 			}
 		}
 
+		stepTrace.End();
+
 		// Calculate the result (least-common-denominator between all the minimum steps)
 		size_t result = std::accumulate(numStepsPerNode.begin(), numStepsPerNode.end(), 1ull, std::lcm<size_t, size_t>);
 
-		std::cout << "Result (size_t): " << result << std::endl;
+		Diag() << "Result (size_t): " << result << '\n';
 
 		return result;
 	}
@@ -64,8 +64,10 @@
 // Analyze your OASIS report and extrapolate the next value for each history. What is the sum of these extrapolated values?
 
 #include "../challenge.h"
+#include "../output.h"
 
 #include <assert.h>
+#include <cstring>
 #include <numeric>
 #include <vector>
 
@@ -207,7 +209,7 @@ struct Day9_1 : public Challenge
 			delete[] writeBuff;
 		}
 
-		std::cout << "Actual result: " << sum << std::endl;
+		Diag() << "Actual result: " << sum << '\n';
 
 		return sum;
 	}
@@ -366,7 +368,7 @@ struct Day9_2 : public Challenge
 			delete[] writeBuff;
 		}
 
-		std::cout << "Actual result: " << sum << std::endl;
+		Diag() << "Actual result: " << sum << '\n';
 
 		return sum;
 	}
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "challenge.h"
+#include "trace.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define AOC_HAS_IO_URING 1
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Splits a whole file into lines the same way the runner's getline loop does: on '\n' only, and with the text after
+// the last '\n' (possibly empty) as the final line
+inline void SplitLines(std::string_view contents, Challenge::Input& out_input)
+{
+	size_t lineStart = 0;
+	while (true)
+	{
+		size_t lineEnd = contents.find('\n', lineStart);
+		if (lineEnd == std::string_view::npos)
+		{
+			out_input.emplace_back(contents.substr(lineStart));
+			break;
+		}
+
+		out_input.emplace_back(contents.substr(lineStart, lineEnd - lineStart));
+		lineStart = lineEnd + 1;
+	}
+}
+
+// Loads many input files at once for batch runs. On Linux the reads go through io_uring with up to queueDepth reads
+// in flight, so the device queue stays busy instead of waiting on one blocking read at a time. Anywhere else (or if
+// io_uring isn't available at runtime) every file is read with plain pread / ifstream instead.
+//
+// onLoaded is called on the loading thread as soon as each file is complete, in completion order, so the caller can
+// hand the buffer straight to the parse stage while the remaining reads are still in flight
+class BulkInputLoader
+{
+public:
+
+	typedef std::function<void(size_t index, std::string&& contents, bool success)> LoadedCallback;
+
+	BulkInputLoader(unsigned _queueDepth = 64) : queueDepth(std::max(_queueDepth, 1u))
+	{
+#if AOC_HAS_IO_URING
+		usingIoUring = SetupRing();
+#endif
+	}
+
+	~BulkInputLoader()
+	{
+#if AOC_HAS_IO_URING
+		TeardownRing();
+#endif
+	}
+
+	BulkInputLoader(const BulkInputLoader&) = delete;
+
+	bool IsUsingIoUring() const { return usingIoUring; }
+
+	void Load(const std::vector<std::string>& paths, const LoadedCallback& onLoaded)
+	{
+		ScopedTrace trace("bulk load", "io", TraceRecorder::Get().IsEnabled() ? std::to_string(paths.size()) + " files" : std::string());
+
+#if AOC_HAS_IO_URING
+		if (usingIoUring)
+		{
+			LoadWithIoUring(paths, onLoaded);
+			return;
+		}
+#endif
+
+		for (size_t i = 0; i < paths.size(); i++)
+		{
+			std::string contents;
+			bool success = ReadWholeFile(paths[i], contents);
+			onLoaded(i, std::move(contents), success);
+		}
+	}
+
+	// Blocking single-file read, used as the fallback path
+	static bool ReadWholeFile(const std::string& path, std::string& out_contents)
+	{
+#if defined(_WIN32)
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		if (!file.good()) return false;
+
+		file.seekg(0, std::ios::end);
+		out_contents.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0, std::ios::beg);
+		file.read(out_contents.data(), out_contents.size());
+		return file.good() || file.eof();
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		out_contents.resize(static_cast<size_t>(fileStat.st_size));
+		size_t offset = 0;
+		while (offset < out_contents.size())
+		{
+			ssize_t bytesRead = pread(fd, out_contents.data() + offset, out_contents.size() - offset, static_cast<off_t>(offset));
+			if (bytesRead < 0 && errno == EINTR) continue;
+			if (bytesRead <= 0) break;
+			offset += static_cast<size_t>(bytesRead);
+		}
+
+		// A file that shrank while we were reading it just ends early
+		out_contents.resize(offset);
+		close(fd);
+		return true;
+#endif
+	}
+
+private:
+
+	unsigned queueDepth;
+	bool usingIoUring = false;
+
+#if AOC_HAS_IO_URING
+
+	// One in-flight file
+	struct Slot
+	{
+		size_t index;
+		int fd;
+		std::string contents;
+		size_t offset;
+	};
+
+	bool SetupRing()
+	{
+		io_uring_params params = {};
+		ringFD = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+		if (ringFD < 0)
+		{
+			// Not supported by this kernel, or blocked by a sandbox
+			return false;
+		}
+
+		sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (singleMap)
+		{
+			sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+		}
+
+		sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQ_RING);
+		if (sqRing == MAP_FAILED)
+		{
+			sqRing = nullptr;
+			TeardownRing();
+			return false;
+		}
+
+		if (singleMap)
+		{
+			cqRing = sqRing;
+		}
+		else
+		{
+			cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_CQ_RING);
+			if (cqRing == MAP_FAILED)
+			{
+				cqRing = nullptr;
+				TeardownRing();
+				return false;
+			}
+		}
+
+		sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQES));
+		if (sqes == MAP_FAILED)
+		{
+			sqes = nullptr;
+			TeardownRing();
+			return false;
+		}
+
+		char* sq = static_cast<char*>(sqRing);
+		sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+		sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+		char* cq = static_cast<char*>(cqRing);
+		cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+		// The kernel may round the queue up, but never down
+		queueDepth = std::min(queueDepth, params.sq_entries);
+		return true;
+	}
+
+	void TeardownRing()
+	{
+		if (sqes != nullptr) munmap(sqes, sqesSize);
+		if (cqRing != nullptr && cqRing != sqRing) munmap(cqRing, cqRingSize);
+		if (sqRing != nullptr) munmap(sqRing, sqRingSize);
+		if (ringFD >= 0) close(ringFD);
+
+		sqes = nullptr;
+		cqRing = nullptr;
+		sqRing = nullptr;
+		ringFD = -1;
+	}
+
+	void QueueRead(const Slot& slot, uint64_t slotIndex)
+	{
+		unsigned tail = *sqTail;
+		unsigned entry = tail & sqMask;
+
+		io_uring_sqe& sqe = sqes[entry];
+		sqe = {};
+		sqe.opcode = IORING_OP_READ;
+		sqe.fd = slot.fd;
+		sqe.addr = reinterpret_cast<uint64_t>(slot.contents.data() + slot.offset);
+		sqe.len = static_cast<uint32_t>(std::min<size_t>(slot.contents.size() - slot.offset, 1u << 30));
+		sqe.off = slot.offset;
+		sqe.user_data = slotIndex;
+
+		sqArray[entry] = entry;
+		__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+		pendingSubmissions++;
+	}
+
+	void LoadWithIoUring(const std::vector<std::string>& paths, const LoadedCallback& onLoaded)
+	{
+		std::vector<Slot> slots(queueDepth);
+		std::vector<uint64_t> freeSlots;
+		for (uint64_t i = 0; i < queueDepth; i++) freeSlots.push_back(queueDepth - 1 - i);
+
+		size_t nextPath = 0;
+		size_t inFlight = 0;
+		pendingSubmissions = 0;
+
+		auto finish = [&](uint64_t slotIndex, bool success)
+		{
+			Slot& slot = slots[slotIndex];
+			close(slot.fd);
+			slot.contents.resize(slot.offset);
+			onLoaded(slot.index, std::move(slot.contents), success);
+			slot.contents = std::string();
+			freeSlots.push_back(slotIndex);
+			inFlight--;
+		};
+
+		while (nextPath < paths.size() || inFlight > 0)
+		{
+			// Top the queue up with new files
+			while (nextPath < paths.size() && !freeSlots.empty())
+			{
+				size_t index = nextPath++;
+
+				int fd = open(paths[index].c_str(), O_RDONLY);
+				struct stat fileStat;
+				if (fd < 0 || fstat(fd, &fileStat) != 0)
+				{
+					if (fd >= 0) close(fd);
+					onLoaded(index, std::string(), false);
+					continue;
+				}
+
+				if (fileStat.st_size == 0)
+				{
+					close(fd);
+					onLoaded(index, std::string(), true);
+					continue;
+				}
+
+				uint64_t slotIndex = freeSlots.back();
+				freeSlots.pop_back();
+
+				Slot& slot = slots[slotIndex];
+				slot.index = index;
+				slot.fd = fd;
+				slot.contents.resize(static_cast<size_t>(fileStat.st_size));
+				slot.offset = 0;
+
+				QueueRead(slot, slotIndex);
+				inFlight++;
+			}
+
+			if (inFlight == 0)
+			{
+				continue;
+			}
+
+			int entered = static_cast<int>(syscall(__NR_io_uring_enter, ringFD, pendingSubmissions, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+			if (entered < 0 && errno == EBUSY)
+			{
+				// The completion queue is full: reap it below, then enter again
+				entered = 0;
+			}
+			else if (entered < 0)
+			{
+				if (errno == EINTR) continue;
+
+				// The ring is unusable. Close it first, which cancels whatever reads the kernel still has, so nothing
+				// writes into the slot buffers anymore. Then finish the slots and everything left with blocking reads,
+				// and don't use the ring again
+				TeardownRing();
+				usingIoUring = false;
+
+				for (uint64_t slotIndex = 0; slotIndex < slots.size(); slotIndex++)
+				{
+					if (std::find(freeSlots.begin(), freeSlots.end(), slotIndex) != freeSlots.end()) continue;
+					finish(slotIndex, CompleteWithPread(slots[slotIndex]));
+				}
+
+				for (; nextPath < paths.size(); nextPath++)
+				{
+					std::string contents;
+					bool success = ReadWholeFile(paths[nextPath], contents);
+					onLoaded(nextPath, std::move(contents), success);
+				}
+				return;
+			}
+			pendingSubmissions -= std::min<unsigned>(pendingSubmissions, static_cast<unsigned>(entered));
+
+			// Reap every completion that's ready
+			unsigned head = *cqHead;
+			unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+			while (head != tail)
+			{
+				const io_uring_cqe& cqe = cqes[head & cqMask];
+				uint64_t slotIndex = cqe.user_data;
+				int result = cqe.res;
+				head++;
+
+				Slot& slot = slots[slotIndex];
+				if (result == -EINVAL || result == -EOPNOTSUPP)
+				{
+					// IORING_OP_READ needs Linux 5.6, older kernels reject it per request
+					finish(slotIndex, CompleteWithPread(slot));
+				}
+				else if (result < 0)
+				{
+					finish(slotIndex, false);
+				}
+				else
+				{
+					slot.offset += static_cast<size_t>(result);
+					if (result == 0 || slot.offset >= slot.contents.size())
+					{
+						finish(slotIndex, true);
+					}
+					else
+					{
+						// Short read, queue up the rest
+						QueueRead(slot, slotIndex);
+					}
+				}
+			}
+			__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+		}
+	}
+
+	// Reads the rest of the slot with blocking reads. Returns false if it ends early, on an error or a file that shrank
+	static bool CompleteWithPread(Slot& slot)
+	{
+		while (slot.offset < slot.contents.size())
+		{
+			ssize_t bytesRead = pread(slot.fd, slot.contents.data() + slot.offset, slot.contents.size() - slot.offset, static_cast<off_t>(slot.offset));
+			if (bytesRead < 0 && errno == EINTR) continue;
+			if (bytesRead <= 0) break;
+			slot.offset += static_cast<size_t>(bytesRead);
+		}
+		return slot.offset == slot.contents.size();
+	}
+
+	int ringFD = -1;
+	unsigned pendingSubmissions = 0;
+
+	void* sqRing = nullptr;
+	void* cqRing = nullptr;
+	size_t sqRingSize = 0;
+	size_t cqRingSize = 0;
+	io_uring_sqe* sqes = nullptr;
+	size_t sqesSize = 0;
+
+	unsigned* sqHead = nullptr;
+	unsigned* sqTail = nullptr;
+	unsigned sqMask = 0;
+	unsigned* sqArray = nullptr;
+
+	unsigned* cqHead = nullptr;
+	unsigned* cqTail = nullptr;
+	unsigned cqMask = 0;
+	io_uring_cqe* cqes = nullptr;
+
+#endif
+};
@@ -1,34 +1,141 @@
-
 #include <assert.h>
 #include <fstream>
-#include <iostream>
 #include <vector>
 
+#include "arguments.h"
+#include "input_loader.h"
+#include "output.h"
+#include "thread_pool.h"
+#include "trace.h"
 #include "day11/day11.h"
 
 static const std::string inputFilePath = "../../src/day11/input11_2.txt";
 
-int main()
+typedef Day11_2 SelectedChallenge;
+
+bool LoadInput(const std::string& path, Challenge::Input& out_input)
 {
 	static constexpr uint32_t MAX_BUFFER_SIZE = 500;
 	char buffer[MAX_BUFFER_SIZE];
-	std::vector<std::string> input;
 
-	std::ifstream fileHandle(inputFilePath.c_str(), std::ios::in);
+	std::ifstream fileHandle(path.c_str(), std::ios::in);
 	if (!fileHandle.good())
 	{
-		std::cout << "[ERROR] Failed to open input file '" << inputFilePath.c_str() << "'!" << std::endl;
-		return -1; 
+		Diag() << "[ERROR] Failed to open input file '" << path.c_str() << "'!" << '\n';
+		return false;
 	}
 
 	while (fileHandle.good())
 	{
 		fileHandle.getline(buffer, MAX_BUFFER_SIZE);
-		input.push_back(buffer);
+		out_input.push_back(buffer);
 	}
 
-	Day11_2 challenge;
-	std::cout << "Output: " << challenge.Run(input) << std::endl;
-
 	fileHandle.close();
-}
\ No newline at end of file
+	return true;
+}
+
+// With no input files the default input is used. Otherwise every file is a batch item: all of them are loaded in bulk,
+// parsed and solved on the thread pool, and the results are printed in the order the files were given
+static const char* const USAGE = "Usage: main [--trace <file.json>] [--threads <count>] [input files...]\n";
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> inputPaths;
+	std::string tracePath;
+	size_t threadCount = std::thread::hardware_concurrency();
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--trace" && i + 1 < argc)
+		{
+			tracePath = argv[++i];
+		}
+		else if (arg == "--threads" && i + 1 < argc)
+		{
+			const char* countStr = argv[++i];
+			if (!ParseCount(countStr, threadCount))
+			{
+				Diag() << "[ERROR] Invalid thread count '" << countStr << "'" << '\n' << USAGE;
+				OutputWriter::Get().Flush();
+				return -1;
+			}
+		}
+		else
+		{
+			inputPaths.push_back(arg);
+		}
+	}
+
+	if (!tracePath.empty())
+	{
+		TraceRecorder::Get().Enable(tracePath);
+		TraceRecorder::Get().NameThread("Main");
+	}
+
+	int returnCode = 0;
+	if (inputPaths.empty())
+	{
+		std::vector<std::string> input;
+		bool loaded = false;
+		{
+			ScopedTrace trace("load", "phase", inputFilePath);
+			loaded = LoadInput(inputFilePath, input);
+		}
+
+		if (loaded)
+		{
+			ScopedTrace trace("solve", "phase", inputFilePath);
+			SelectedChallenge challenge;
+			Result(0) << "Output: " << challenge.Run(input) << '\n';
+		}
+		else
+		{
+			returnCode = -1;
+		}
+	}
+	else
+	{
+		ThreadPool& pool = ThreadPool::Get(threadCount);
+
+		// Files are read with many requests in flight, and each one is handed to the pool for parsing and solving as
+		// soon as its read completes
+		BulkInputLoader loader;
+		loader.Load(inputPaths, [&pool, &inputPaths](size_t i, std::string&& contents, bool success)
+		{
+			const std::string& path = inputPaths[i];
+			if (!success)
+			{
+				Diag() << "[ERROR] Failed to open input file '" << path << "'!" << '\n';
+				Result(i) << path << ": [ERROR] Failed to load\n";
+				return;
+			}
+
+			pool.Enqueue([&path, i, contents = std::move(contents)]()
+			{
+				ScopedTrace itemTrace("batch item", "batch", path);
+
+				std::vector<std::string> input;
+				{
+					ScopedTrace trace("parse", "phase", path);
+					SplitLines(contents, input);
+				}
+
+				ScopedTrace trace("solve", "phase", path);
+				SelectedChallenge challenge;
+				int output = challenge.Run(input);
+				Result(i) << path << ": " << output << '\n';
+			}, "batch task");
+		});
+		pool.Wait();
+	}
+
+	if (!TraceRecorder::Get().Write())
+	{
+		Diag() << "[ERROR] Failed to write trace file '" << tracePath << "'!" << '\n';
+	}
+
+	OutputWriter::Get().Flush();
+	return returnCode;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only view of a whole file mapped into memory. Inputs that are far bigger than RAM can be scanned through this
+// without ever being copied, the OS pages the file in (and out again) as the scan moves along
+class MappedFile
+{
+public:
+
+	MappedFile() = default;
+
+	~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& path)
+	{
+		Close();
+
+#if defined(_WIN32)
+		fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize))
+		{
+			Close();
+			return false;
+		}
+
+		size = static_cast<size_t>(fileSize.QuadPart);
+		if (size == 0)
+		{
+			// Empty files can't be mapped, but they're still valid (empty) inputs
+			return true;
+		}
+
+		mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mappingHandle == nullptr)
+		{
+			Close();
+			return false;
+		}
+
+		data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (data == nullptr)
+		{
+			Close();
+			return false;
+		}
+#else
+		fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0)
+		{
+			Close();
+			return false;
+		}
+
+		size = static_cast<size_t>(fileStat.st_size);
+		if (size == 0)
+		{
+			// Empty files can't be mapped, but they're still valid (empty) inputs
+			return true;
+		}
+
+		void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED)
+		{
+			Close();
+			return false;
+		}
+
+		// Only a hint, so the result doesn't matter
+		madvise(mapping, size, MADV_SEQUENTIAL);
+		data = static_cast<const char*>(mapping);
+#endif
+
+		return true;
+	}
+
+	void Close()
+	{
+#if defined(_WIN32)
+		if (data != nullptr) UnmapViewOfFile(data);
+		if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+		if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+
+		mappingHandle = nullptr;
+		fileHandle = INVALID_HANDLE_VALUE;
+#else
+		if (data != nullptr) munmap(const_cast<char*>(data), size);
+		if (fd >= 0) close(fd);
+
+		fd = -1;
+#endif
+
+		data = nullptr;
+		size = 0;
+	}
+
+	const char* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+	std::string_view GetView() const { return std::string_view(data, size); }
+
+private:
+
+	const char* data = nullptr;
+	size_t size = 0;
+
+#if defined(_WIN32)
+	HANDLE fileHandle = INVALID_HANDLE_VALUE;
+	HANDLE mappingHandle = nullptr;
+#else
+	int fd = -1;
+#endif
+};
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Buffered replacement for std::cout. Every thread appends into its own buffer, and the buffer is only handed over
+// to stdout once it grows past FLUSH_THRESHOLD (or when the thread exits / Flush() is called), so dumping a whole
+// grid costs a few large writes instead of one flush per line.
+//
+// There are two modes:
+//  - Diagnostics (Diag()) are unordered. Blocks coming from different threads never interleave mid-statement, but
+//    they may show up in any order relative to each other
+//  - Results (Result(sequence)) are ordered. Each result is tagged with a sequence number and is only written once
+//    every result with a lower sequence number has been written, which keeps batch output deterministic
+class OutputWriter
+{
+public:
+
+	static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+	static OutputWriter& Get()
+	{
+		static OutputWriter writer;
+		return writer;
+	}
+
+	// Appends any printable value to a buffer, the same way operator<< on std::cout would (minus the locale)
+	template<typename T>
+	static void Append(std::string& out_buffer, const T& value)
+	{
+		if constexpr (std::is_same_v<T, char>)
+		{
+			out_buffer.push_back(value);
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			out_buffer.push_back(value ? '1' : '0');
+		}
+		else if constexpr (std::is_arithmetic_v<T>)
+		{
+			char number[64];
+			auto result = std::to_chars(number, number + sizeof(number), value);
+			out_buffer.append(number, result.ptr);
+		}
+		else
+		{
+			out_buffer.append(std::string_view(value));
+		}
+	}
+
+	// Temporary returned by Diag(). It writes straight into the calling thread's buffer, and only checks whether
+	// the buffer should be handed over once the whole statement is done
+	class DiagStream
+	{
+	public:
+
+		// A null buffer means diagnostics are muted, and everything streamed in is dropped without being formatted
+		DiagStream(std::string* _buffer) : buffer(_buffer)
+		{
+		}
+
+		DiagStream(const DiagStream&) = delete;
+
+		~DiagStream()
+		{
+			if (buffer != nullptr && buffer->size() >= FLUSH_THRESHOLD)
+			{
+				OutputWriter::Get().WriteBlock(*buffer);
+			}
+		}
+
+		template<typename T>
+		DiagStream& operator<<(const T& value)
+		{
+			if (buffer != nullptr)
+			{
+				Append(*buffer, value);
+			}
+			return *this;
+		}
+
+	private:
+
+		std::string* buffer;
+	};
+
+	// Temporary returned by Result(). The text is collected privately and committed under its sequence number once
+	// the statement is done
+	class ResultStream
+	{
+	public:
+
+		ResultStream(size_t _sequence) : sequence(_sequence)
+		{
+		}
+
+		ResultStream(const ResultStream&) = delete;
+
+		~ResultStream()
+		{
+			OutputWriter::Get().CommitResult(sequence, std::move(text));
+		}
+
+		template<typename T>
+		ResultStream& operator<<(const T& value)
+		{
+			Append(text, value);
+			return *this;
+		}
+
+	private:
+
+		size_t sequence;
+		std::string text;
+	};
+
+	DiagStream Diag()
+	{
+		if (!diagnosticsEnabled)
+		{
+			return DiagStream(nullptr);
+		}
+
+		return DiagStream(&GetThreadBuffer().text);
+	}
+
+	ResultStream Result(size_t sequence)
+	{
+		return ResultStream(sequence);
+	}
+
+	void CommitResult(size_t sequence, std::string text)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		pendingResults.insert({ sequence, std::move(text) });
+
+		// Release every result that is now contiguous with what has already been written
+		auto iter = pendingResults.begin();
+		while (iter != pendingResults.end() && iter->first == nextSequence)
+		{
+			orderedBuffer += iter->second;
+			iter = pendingResults.erase(iter);
+			nextSequence++;
+		}
+
+		if (orderedBuffer.size() >= FLUSH_THRESHOLD)
+		{
+			WriteLocked(orderedBuffer);
+		}
+	}
+
+	// Hands a block of text over to stdout and clears it
+	void WriteBlock(std::string& block)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		WriteLocked(block);
+	}
+
+	// Writes out the calling thread's diagnostics and every result that is ready. Results whose predecessors haven't
+	// been committed yet stay pending
+	void Flush()
+	{
+		std::string& threadBuffer = GetThreadBuffer().text;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		WriteLocked(threadBuffer);
+		WriteLocked(orderedBuffer);
+		std::fflush(stdout);
+	}
+
+	// Diagnostics can be muted entirely, e.g. while benchmarking. Results are never muted
+	void SetDiagnosticsEnabled(bool enabled)
+	{
+		diagnosticsEnabled = enabled;
+	}
+
+private:
+
+	struct ThreadBuffer
+	{
+		std::string text;
+
+		~ThreadBuffer()
+		{
+			// Whatever is left when the thread exits still has to make it out
+			OutputWriter::Get().WriteBlock(text);
+		}
+	};
+
+	OutputWriter() = default;
+
+	~OutputWriter()
+	{
+		WriteLocked(orderedBuffer);
+		std::fflush(stdout);
+	}
+
+	static ThreadBuffer& GetThreadBuffer()
+	{
+		thread_local ThreadBuffer buffer;
+		if (buffer.text.capacity() < FLUSH_THRESHOLD)
+		{
+			buffer.text.reserve(FLUSH_THRESHOLD * 2);
+		}
+		return buffer;
+	}
+
+	void WriteLocked(std::string& block)
+	{
+		if (block.empty()) return;
+
+		std::fwrite(block.data(), 1, block.size(), stdout);
+		block.clear();
+	}
+
+	std::mutex mutex;
+	std::map<size_t, std::string> pendingResults;
+	std::string orderedBuffer;
+	size_t nextSequence = 0;
+	std::atomic<bool> diagnosticsEnabled = true;
+};
+
+// Shorthands used by the solvers
+inline OutputWriter::DiagStream Diag()
+{
+	return OutputWriter::Get().Diag();
+}
+
+inline OutputWriter::ResultStream Result(size_t sequence)
+{
+	return OutputWriter::Get().Result(sequence);
+}
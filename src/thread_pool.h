@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "output.h"
+#include "trace.h"
+
+// Fixed-size pool of worker threads shared by the runner and the parallel engines. Tasks are plain closures,
+// and Wait() blocks until every task enqueued so far has finished
+class ThreadPool
+{
+public:
+
+	ThreadPool(size_t threadCount)
+	{
+		// Workers flush their output and trace buffers on exit, so both singletons have to outlive the pool
+		OutputWriter::Get();
+		TraceRecorder::Get();
+
+		threadCount = std::max<size_t>(threadCount, 1);
+		workers.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; i++)
+		{
+			workers.emplace_back(&ThreadPool::Worker, this, i);
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		taskAvailable.notify_all();
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	// Shared pool used when an engine isn't handed one explicitly. The size can only be chosen before first use
+	static ThreadPool& Get(size_t threadCount = std::thread::hardware_concurrency())
+	{
+		static ThreadPool pool(threadCount);
+		return pool;
+	}
+
+	size_t GetThreadCount() const { return workers.size(); }
+
+	void Enqueue(std::function<void()> task, const char* traceName = "task")
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push({ std::move(task), traceName });
+			pendingTasks++;
+		}
+		taskAvailable.notify_one();
+	}
+
+	void Wait()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		allTasksDone.wait(lock, [this]() { return pendingTasks == 0; });
+	}
+
+	// Runs func(i) for every i in [0, count) on the pool and waits for all of them
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func, const char* traceName = "task")
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			Enqueue([&func, i]() { func(i); }, traceName);
+		}
+		Wait();
+	}
+
+private:
+
+	struct Task
+	{
+		std::function<void()> func;
+		const char* traceName;
+	};
+
+	void Worker(size_t workerIndex)
+	{
+		if (TraceRecorder::Get().IsEnabled())
+		{
+			TraceRecorder::Get().NameThread("Pool worker " + std::to_string(workerIndex));
+		}
+
+		while (true)
+		{
+			Task task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+				if (tasks.empty())
+				{
+					// Only reachable when stopping
+					return;
+				}
+
+				task = std::move(tasks.front());
+				tasks.pop();
+			}
+
+			{
+				ScopedTrace trace(task.traceName, "pool");
+				task.func();
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pendingTasks--;
+				if (pendingTasks == 0)
+				{
+					allTasksDone.notify_all();
+				}
+			}
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::queue<Task> tasks;
+	size_t pendingTasks = 0;
+	bool stopping = false;
+
+	std::mutex mutex;
+	std::condition_variable taskAvailable;
+	std::condition_variable allTasksDone;
+};
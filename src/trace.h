@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Records spans in the Chrome trace_event JSON format, so a run can be opened in chrome://tracing or ui.perfetto.dev
+// and every thread shows up as its own timeline.
+// Recording is off until Enable() is called. A disabled ScopedTrace costs a single branch, but its arguments are still
+// built before that, so callers that format names or details only do it when IsEnabled() is true
+class TraceRecorder
+{
+public:
+
+	struct Event
+	{
+		std::string name;
+		std::string category;
+		std::string detail;
+		int64_t startMicroseconds;
+		int64_t durationMicroseconds;
+		uint32_t threadID;
+	};
+
+	static TraceRecorder& Get()
+	{
+		static TraceRecorder recorder;
+		return recorder;
+	}
+
+	void Enable(const std::string& _outputPath)
+	{
+		outputPath = _outputPath;
+		epoch = std::chrono::steady_clock::now();
+		enabled = true;
+	}
+
+	bool IsEnabled() const { return enabled; }
+
+	// Independently of the JSON trace, span durations can be summed up per span name. The benchmark uses this to get
+	// per-phase timings out of the same spans the solvers already declare
+	void SetCollectingPhaseTotals(bool collecting)
+	{
+		collectingPhaseTotals = collecting;
+	}
+
+	bool IsCollectingPhaseTotals() const { return collectingPhaseTotals; }
+
+	void AddPhaseTotal(const char* name, int64_t nanoseconds)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		phaseTotals[name] += nanoseconds;
+	}
+
+	// Returns the totals gathered so far and starts over
+	std::map<std::string, int64_t> TakePhaseTotals()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::map<std::string, int64_t> totals;
+		totals.swap(phaseTotals);
+		return totals;
+	}
+
+	std::chrono::steady_clock::time_point GetEpoch() const { return epoch; }
+
+	// Events are kept per thread while recording, and only merged when the thread exits or the trace is written
+	void Record(Event&& event)
+	{
+		ThreadEvents& threadEvents = GetThreadEvents();
+		event.threadID = threadEvents.threadID;
+		threadEvents.events.push_back(std::move(event));
+	}
+
+	// Gives the calling thread a readable name in the viewer
+	void NameThread(const std::string& name)
+	{
+		if (!enabled) return;
+
+		ThreadEvents& threadEvents = GetThreadEvents();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		threadNames.push_back({ threadEvents.threadID, name });
+	}
+
+	// Writes every event recorded so far. Should be called once all worker threads are idle, since their buffers are
+	// read without them knowing
+	bool Write()
+	{
+		if (!enabled) return true;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for (ThreadEvents* threadEvents : liveThreads)
+		{
+			MergeLocked(*threadEvents);
+		}
+
+		FILE* file = std::fopen(outputPath.c_str(), "wb");
+		if (file == nullptr) return false;
+
+		std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool first = true;
+		for (const auto& threadName : threadNames)
+		{
+			if (!first) json += ",\n";
+			first = false;
+
+			json += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" + std::to_string(threadName.first);
+			json += ",\"args\":{\"name\":\"";
+			AppendEscaped(json, threadName.second);
+			json += "\"}}";
+		}
+
+		for (const auto& event : mergedEvents)
+		{
+			if (!first) json += ",\n";
+			first = false;
+
+			json += "{\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(event.threadID);
+			json += ",\"ts\":" + std::to_string(event.startMicroseconds);
+			json += ",\"dur\":" + std::to_string(event.durationMicroseconds);
+			json += ",\"name\":\"";
+			AppendEscaped(json, event.name);
+			json += "\",\"cat\":\"";
+			AppendEscaped(json, event.category);
+			json += "\"";
+			if (!event.detail.empty())
+			{
+				json += ",\"args\":{\"detail\":\"";
+				AppendEscaped(json, event.detail);
+				json += "\"}";
+			}
+			json += "}";
+		}
+		json += "\n]}\n";
+
+		bool success = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+		std::fclose(file);
+		return success;
+	}
+
+private:
+
+	struct ThreadEvents
+	{
+		uint32_t threadID;
+		std::vector<Event> events;
+
+		ThreadEvents(uint32_t _threadID) : threadID(_threadID)
+		{
+			TraceRecorder& recorder = TraceRecorder::Get();
+
+			std::lock_guard<std::mutex> lock(recorder.mutex);
+			recorder.liveThreads.push_back(this);
+		}
+
+		~ThreadEvents()
+		{
+			TraceRecorder& recorder = TraceRecorder::Get();
+
+			std::lock_guard<std::mutex> lock(recorder.mutex);
+			recorder.MergeLocked(*this);
+			recorder.liveThreads.erase(std::find(recorder.liveThreads.begin(), recorder.liveThreads.end(), this));
+		}
+	};
+
+	TraceRecorder() = default;
+
+	ThreadEvents& GetThreadEvents()
+	{
+		thread_local ThreadEvents threadEvents(nextThreadID++);
+		return threadEvents;
+	}
+
+	void MergeLocked(ThreadEvents& threadEvents)
+	{
+		for (auto& event : threadEvents.events)
+		{
+			mergedEvents.push_back(std::move(event));
+		}
+		threadEvents.events.clear();
+	}
+
+	static void AppendEscaped(std::string& out_json, const std::string& text)
+	{
+		for (const auto c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out_json += '\\';
+				out_json += c;
+			}
+			else if (static_cast<unsigned char>(c) < 0x20)
+			{
+				char escaped[8];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				out_json += escaped;
+			}
+			else
+			{
+				out_json += c;
+			}
+		}
+	}
+
+	std::atomic<bool> enabled = false;
+	std::atomic<bool> collectingPhaseTotals = false;
+	std::atomic<uint32_t> nextThreadID = 1;
+	std::string outputPath;
+	std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	std::mutex mutex;
+	std::vector<Event> mergedEvents;
+	std::vector<ThreadEvents*> liveThreads;
+	std::vector<std::pair<uint32_t, std::string>> threadNames;
+	std::map<std::string, int64_t> phaseTotals;
+};
+
+// Records a complete ("X") event covering its own lifetime, or until End() is called
+class ScopedTrace
+{
+public:
+
+	ScopedTrace(const char* _name, const char* _category, std::string _detail = "")
+	{
+		TraceRecorder& recorder = TraceRecorder::Get();
+		if (!recorder.IsEnabled() && !recorder.IsCollectingPhaseTotals()) return;
+
+		active = true;
+		name = _name;
+		category = _category;
+		detail = std::move(_detail);
+		start = std::chrono::steady_clock::now();
+	}
+
+	ScopedTrace(const ScopedTrace&) = delete;
+
+	~ScopedTrace()
+	{
+		End();
+	}
+
+	void End()
+	{
+		if (!active) return;
+		active = false;
+
+		auto end = std::chrono::steady_clock::now();
+		TraceRecorder& recorder = TraceRecorder::Get();
+
+		if (recorder.IsCollectingPhaseTotals())
+		{
+			recorder.AddPhaseTotal(name, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+		}
+
+		if (recorder.IsEnabled())
+		{
+			int64_t startMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(start - recorder.GetEpoch()).count();
+			int64_t durationMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+			recorder.Record({ name, category, std::move(detail), startMicroseconds, durationMicroseconds, 0 });
+		}
+	}
+
+private:
+
+	bool active = false;
+	const char* name = nullptr;
+	const char* category = nullptr;
+	std::string detail;
+	std::chrono::steady_clock::time_point start;
+};